@@ -6,8 +6,11 @@
 
 #include <QMessageBox>
 
+#include "dialog/ConsolidationDialog.h"
 #include "dialog/OutputInfoDialog.h"
 #include "dialog/OutputSweepDialog.h"
+#include "libwalletqt/FeeEstimator.h"
+#include "libwalletqt/TransactionBatcher.h"
 #include "utils/Icons.h"
 #include "utils/Utils.h"
 
@@ -21,6 +24,7 @@ CoinsWidget::CoinsWidget(Wallet *wallet, QWidget *parent)
         , m_wallet(wallet)
         , m_headerMenu(new QMenu(this))
         , m_copyMenu(new QMenu("Copy",this))
+        , m_consolidationBatcher(new TransactionBatcher(wallet, this))
 {
     ui->setupUi(this);
 
@@ -28,6 +32,7 @@ CoinsWidget::CoinsWidget(Wallet *wallet, QWidget *parent)
     ui->coins->header()->setContextMenuPolicy(Qt::CustomContextMenu);
     m_showSpentAction = m_headerMenu->addAction("Show spent outputs", this, &CoinsWidget::setShowSpent);
     m_showSpentAction->setCheckable(true);
+    m_headerMenu->addAction("Consolidate outputs…", this, &CoinsWidget::onConsolidate);
     connect(ui->coins->header(), &QHeaderView::customContextMenuRequested, this, &CoinsWidget::showHeaderMenu);
     ui->btn_options->setMenu(m_headerMenu);
 
@@ -78,6 +83,12 @@ CoinsWidget::CoinsWidget(Wallet *wallet, QWidget *parent)
     connect(ui->search, &QLineEdit::textChanged, this, &CoinsWidget::setSearchFilter);
 
     connect(m_wallet, &Wallet::selectedInputsChanged, this, &CoinsWidget::selectCoins);
+
+    connect(m_consolidationBatcher, &TransactionBatcher::abandoned, this, &CoinsWidget::onConsolidationAbandoned);
+    connect(m_consolidationBatcher, &TransactionBatcher::finished, [this]{
+        m_consolidation.clear();
+    });
+    connect(m_wallet->feeEstimator(), &FeeEstimator::estimateUpdated, m_consolidationBatcher, &TransactionBatcher::resume);
 }
 
 void CoinsWidget::setModel(CoinsModel * model, Coins * coins) {
@@ -283,6 +294,91 @@ void CoinsWidget::onSweepOutputs() {
     m_wallet->preTransactionChecks(dialog.feeLevel());
 }
 
+void CoinsWidget::onConsolidate() {
+    if (!m_wallet->isConnected()) {
+        Utils::showError(this, "Unable to consolidate outputs", "Wallet is not connected to a node.",
+                         {"Wait for the wallet to automatically connect to a node.", "Go to File -> Settings -> Network -> Node to manually connect to a node."},
+                         "nodes");
+        return;
+    }
+
+    if (!m_wallet->isSynchronized()) {
+        Utils::showError(this, "Unable to consolidate outputs", "Wallet is not synchronized", {"Wait for wallet synchronization to complete"}, "synchronization");
+        return;
+    }
+
+    if (m_wallet->viewOnly()) {
+        Utils::showError(this, "Unable to consolidate outputs", "Consolidation is not available for view-only wallets.", {"Select the outputs to sweep by hand and use 'Sweep selected outputs'."});
+        return;
+    }
+
+    if (m_consolidationBatcher->isActive()) {
+        const qsizetype count = m_consolidationBatcher->count();
+        auto result = QMessageBox::question(this, "Consolidate outputs", QString("A consolidation is in progress, %1 of %2 transactions have not been sent yet.\n\n"
+                                                                                 "Abandon it and plan a new one?")
+                                                                                 .arg(QString::number(count - m_consolidationBatcher->sent()), QString::number(count)));
+        if (result != QMessageBox::Yes) {
+            return;
+        }
+        m_consolidationBatcher->stop();
+        m_consolidation.clear();
+    }
+
+    ConsolidationDialog dialog{m_wallet, this};
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+
+    m_consolidation = dialog.plan().batches;
+    m_consolidationFeeLevel = dialog.feeLevel();
+    m_consolidationWaitForBacklog = dialog.waitForLowBacklog();
+
+    const bool backlog = m_consolidationWaitForBacklog && m_wallet->feeEstimator()->blocksForFeeLevel(m_consolidationFeeLevel) != 0;
+
+    m_consolidationBatcher->start(m_consolidation.size(), [this](qsizetype index){
+        return this->createConsolidationBatch(index);
+    });
+
+    if (backlog) {
+        Utils::showInfo(this, "Consolidation scheduled", "The transaction pool has a backlog at the selected fee level.\n\n"
+                                                        "The consolidation starts once it has cleared. Keep this wallet open.");
+    }
+}
+
+bool CoinsWidget::createConsolidationBatch(qsizetype index) {
+    // Hold off until the next fee estimate if transactions at this fee level would not make it into the next block
+    if (m_consolidationWaitForBacklog && m_wallet->feeEstimator()->blocksForFeeLevel(m_consolidationFeeLevel) != 0) {
+        qInfo() << "Consolidation: waiting for the transaction pool backlog to clear";
+        return false;
+    }
+
+    const ConsolidationBatch &batch = m_consolidation[index];
+    QVector<QString> keyImages(batch.keyImages.begin(), batch.keyImages.end());
+    QString address = m_wallet->address(m_wallet->currentSubaddressAccount(), batch.subaddrIndex);
+
+    qInfo() << "Consolidation: sweeping" << keyImages.size() << "outputs, transaction" << index + 1 << "of" << m_consolidation.size();
+
+    QtFuture::connect(m_wallet, &Wallet::preTransactionChecksComplete)
+            .then([this, keyImages, address](int feeLevel){
+                m_wallet->sweepOutputs(keyImages, address, false, 1, feeLevel);
+            });
+
+    m_wallet->preTransactionChecks(m_consolidationFeeLevel);
+    return true;
+}
+
+void CoinsWidget::onConsolidationAbandoned(qsizetype sent, qsizetype count, const QString &reason) {
+    qsizetype outputs = 0;
+    for (qsizetype i = sent; i < m_consolidation.size(); i++) {
+        outputs += m_consolidation[i].keyImages.size();
+    }
+    m_consolidation.clear();
+
+    Utils::showError(this, "Consolidation interrupted", QString("%1 of %2 transactions were sent, %3 outputs were not consolidated.\n\n%4")
+                             .arg(QString::number(sent), QString::number(count), QString::number(outputs), reason),
+                     {"Open 'Consolidate outputs' again to plan the remaining outputs."});
+}
+
 void CoinsWidget::copy(copyField field) {
     auto index = this->getCurrentIndex();
     if (!index.isValid()) {
@@ -13,6 +13,8 @@
 #include "libwalletqt/Coins.h"
 #include "libwalletqt/Wallet.h"
 
+class TransactionBatcher;
+
 namespace Ui {
     class CoinsWidget;
 }
@@ -43,6 +45,7 @@ private slots:
     void spendSelected();
     void viewOutput();
     void onSweepOutputs();
+    void onConsolidate();
     void setSearchFilter(const QString &filter);
     void editLabel();
 
@@ -51,6 +54,9 @@ private:
     void thawCoins(QStringList &pubkeys);
     void selectCoins(const QStringList &pubkeys);
 
+    bool createConsolidationBatch(qsizetype index);
+    void onConsolidationAbandoned(qsizetype sent, qsizetype count, const QString &reason);
+
     enum copyField {
         PubKey = 0,
         KeyImage,
@@ -81,6 +87,12 @@ private:
     CoinsModel * m_model;
     CoinsProxyModel * m_proxyModel;
 
+    // Consolidation batches are sent one transaction at a time
+    TransactionBatcher *m_consolidationBatcher;
+    QVector<ConsolidationBatch> m_consolidation;
+    int m_consolidationFeeLevel = 0;
+    bool m_consolidationWaitForBacklog = false;
+
     void showContextMenu(const QPoint & point);
     void copy(copyField field);
     QStringList selectedPubkeys();
@@ -187,22 +187,18 @@ void ContactsWidget::newContact(QString address, QString name)
         std::swap(address, name);
     }
 
-    auto& rows = m_wallet->addressBook()->getRows();
-    for (int i = 0; i < rows.size(); i++) {
-        const ContactRow& row = rows[i];
-
-        if (address == row.address) {
-            Utils::showError(this, "Unable to add contact", "Address already exists in contacts", {}, "add_contact");
-            QModelIndex sourceIndex = m_model->index(i, 0);
-            ui->contacts->setCurrentIndex(m_proxyModel->mapFromSource(sourceIndex)); // Highlight duplicate address
-            return;
-        }
+    qsizetype duplicate = m_wallet->addressBook()->indexOfAddress(address);
+    if (duplicate >= 0) {
+        Utils::showError(this, "Unable to add contact", "Address already exists in contacts", {}, "add_contact");
+        QModelIndex sourceIndex = m_model->index(duplicate, 0);
+        ui->contacts->setCurrentIndex(m_proxyModel->mapFromSource(sourceIndex)); // Highlight duplicate address
+        return;
+    }
 
-        if (name == row.label) {
-            Utils::showError(this, "Unable to add contact", "Label already exists in contacts", {}, "add_contact");
-            this->newContact(address, name);
-            return;
-        }
+    if (m_wallet->addressBook()->indexOfDescription(name) >= 0) {
+        Utils::showError(this, "Unable to add contact", "Label already exists in contacts", {}, "add_contact");
+        this->newContact(address, name);
+        return;
     }
 
     m_wallet->addressBook()->addRow(address, name);
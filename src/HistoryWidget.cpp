@@ -127,7 +127,7 @@ void HistoryWidget::onResendTransaction() {
     }
 
     const TransactionRow& tx = ui->history->sourceModel()->entryFromIndex(index);
-    emit resendTransaction(tx.hash);
+    emit resendTransaction(tx.hash());
 }
 
 void HistoryWidget::onRemoveFromHistory() {
@@ -145,7 +145,7 @@ void HistoryWidget::onRemoveFromHistory() {
 
     auto result = QMessageBox::question(this, "Remove transaction from history", "Are you sure you want to remove this transaction from the history?");
     if (result == QMessageBox::Yes) {
-        m_wallet->removeFailedTx(tx.hash);
+        m_wallet->removeFailedTx(tx.hash());
     }
 }
 
@@ -192,7 +192,7 @@ void HistoryWidget::onViewOnBlockExplorer() {
 
     const TransactionRow& tx = ui->history->sourceModel()->entryFromIndex(index);
 
-    emit viewOnBlockExplorer(tx.hash);
+    emit viewOnBlockExplorer(tx.hash());
 }
 
 void HistoryWidget::setSearchText(const QString &text) {
@@ -238,7 +238,7 @@ void HistoryWidget::copy(copyField field) {
     QString data = [field, tx]{
         switch(field) {
             case copyField::TxID:
-                return tx.hash;
+                return tx.hash();
             case copyField::Description:
                 return tx.description;
             case copyField::Date:
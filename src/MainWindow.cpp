@@ -15,6 +15,7 @@
 #include "dialog/DebugInfoDialog.h"
 #include "dialog/HistoryExportDialog.h"
 #include "dialog/PasswordDialog.h"
+#include "dialog/ProofBatchDialog.h"
 #include "dialog/TxBroadcastDialog.h"
 #include "dialog/TxConfAdvDialog.h"
 #include "dialog/TxConfDialog.h"
@@ -27,6 +28,7 @@
 #include "libwalletqt/AddressBook.h"
 #include "libwalletqt/rows/CoinsInfo.h"
 #include "libwalletqt/rows/Output.h"
+#include "libwalletqt/SyncMetrics.h"
 #include "libwalletqt/TransactionHistory.h"
 #include "model/AddressBookModel.h"
 #include "plugins/PluginRegistry.h"
@@ -34,6 +36,7 @@
 #include "utils/AsyncTask.h"
 #include "utils/ColorScheme.h"
 #include "utils/Icons.h"
+#include "utils/ScopeGuard.h"
 #include "utils/TorManager.h"
 #include "utils/WebsocketNotifier.h"
 
@@ -108,7 +111,6 @@ MainWindow::MainWindow(WindowManager *windowManager, Wallet *wallet, QWidget *pa
     QTimer::singleShot(1, [this]{this->updateWidgetIcons();});
 
     // Timers
-    connect(&m_updateBytes, &QTimer::timeout, this, &MainWindow::updateNetStats);
     connect(&m_txTimer, &QTimer::timeout, [this]{
         m_statusLabelStatus->setText("Constructing transaction" + this->statusDots());
     });
@@ -317,6 +319,7 @@ void MainWindow::initMenu() {
     connect(ui->actionRescan_spent,          &QAction::triggered, this, &MainWindow::rescanSpent);
     connect(ui->actionWallet_cache_debug,    &QAction::triggered, this, &MainWindow::showWalletCacheDebugDialog);
     connect(ui->actionTxPoolViewer,          &QAction::triggered, this, &MainWindow::showTxPoolViewerDialog);
+    connect(ui->actionSyncOverview,          &QAction::triggered, this, &MainWindow::showSyncOverviewDialog);
 
     // [Wallet] -> [History]
     connect(ui->actionExport_CSV, &QAction::triggered, this, &MainWindow::onExportHistoryCSV);
@@ -372,12 +375,14 @@ void MainWindow::initMenu() {
     // [Tools]
     connect(ui->actionSignVerify,                  &QAction::triggered, this, &MainWindow::menuSignVerifyClicked);
     connect(ui->actionVerifyTxProof,               &QAction::triggered, this, &MainWindow::menuVerifyTxProof);
+    connect(ui->actionBatchProofs,                 &QAction::triggered, this, &MainWindow::menuBatchProofs);
     connect(ui->actionKeyImageSync,                &QAction::triggered, this, &MainWindow::showKeyImageSyncWizard);
     connect(ui->actionLoadSignedTxFromFile,        &QAction::triggered, this, &MainWindow::loadSignedTx);
     connect(ui->actionLoadSignedTxFromText,        &QAction::triggered, this, &MainWindow::loadSignedTxFromText);
     connect(ui->actionImport_transaction,          &QAction::triggered, this, &MainWindow::importTransaction);
     connect(ui->actionTransmitOverUR,              &QAction::triggered, this, &MainWindow::showURDialog);
     connect(ui->actionPay_to_many,                 &QAction::triggered, this, &MainWindow::payToMany);
+    connect(ui->actionImport_payouts,              &QAction::triggered, this, &MainWindow::importPayouts);
     connect(ui->actionAddress_checker,             &QAction::triggered, this, &MainWindow::showAddressChecker);
     connect(ui->actionCreateDesktopEntry,          &QAction::triggered, this, &MainWindow::onCreateDesktopEntry);
 
@@ -483,6 +488,7 @@ void MainWindow::initOffline() {
 void MainWindow::initWalletContext() {
     connect(m_wallet, &Wallet::balanceUpdated,           this, &MainWindow::onBalanceUpdated);
     connect(m_wallet, &Wallet::syncStatus,               this, &MainWindow::onSyncStatus);
+    connect(m_wallet->syncMetrics(), &SyncMetrics::metricsUpdated, this, &MainWindow::updateNetStats);
     connect(m_wallet, &Wallet::transactionCreated,       this, &MainWindow::onTransactionCreated);
     connect(m_wallet, &Wallet::transactionCommitted,     this, &MainWindow::onTransactionCommitted);
     connect(m_wallet, &Wallet::initiateTransaction,      this, &MainWindow::onInitiateTransaction);
@@ -577,12 +583,11 @@ void MainWindow::onWalletOpened() {
         }
     }
 
-    // history page
-    m_wallet->history()->refresh();
-
-    // coins page
-    m_wallet->coins()->refresh();
+    // History and coins are filled on a worker thread when their tab is first shown, so the window shows the
+    // balance and sync status without waiting for them
     m_coinsWidget->setModel(m_wallet->coinsModel(), m_wallet->coins());
+    connect(ui->tabWidget, &QTabWidget::currentChanged, this, &MainWindow::loadTab);
+    this->loadTab(ui->tabWidget->currentIndex());
     m_wallet->coinsModel()->setCurrentSubaddressAccount(m_wallet->currentSubaddressAccount());
 
     // Coin labeling uses set_tx_note, so we need to refresh history too
@@ -598,7 +603,6 @@ void MainWindow::onWalletOpened() {
     this->updateTitle();
     m_nodes->allowConnection();
     m_nodes->connectToNode();
-    m_updateBytes.start(250);
 
     if (conf()->get(Config::writeRecentlyOpenedWallets).toBool()) {
         this->addToRecentlyOpened(m_wallet->cachePath());
@@ -630,9 +634,7 @@ void MainWindow::onBalanceUpdated(quint64 balance, quint64 spendable) {
     }
 
     if (conf()->get(Config::balanceShowFiat).toBool() && !hide) {
-        QString fiatCurrency = conf()->get(Config::preferredFiatCurrency).toString();
-        double balanceFiatAmount = appData()->prices.convert("XMR", fiatCurrency, balance / constants::cdiv);
-        balance_str += QString(" (%1)").arg(Utils::amountToCurrencyString(balanceFiatAmount, fiatCurrency));
+        balance_str += " " + appData()->prices.atomicUnitsToPreferredFiatString(balance, true);
     }
 
     m_statusLabelBalance->setToolTip("Click for details");
@@ -752,7 +754,8 @@ void MainWindow::onSyncStatus(quint64 height, quint64 target, bool daemonSync) {
     if (height >= (target - 1)) {
         this->updateNetStats();
     }
-    this->setStatusText(Utils::formatSyncStatus(height, target, daemonSync));
+    qint64 eta = daemonSync ? -1 : m_wallet->syncMetrics()->eta();
+    this->setStatusText(Utils::formatSyncStatus(height, target, daemonSync, eta));
     m_statusLabelStatus->setToolTip(QString("Wallet height: %1").arg(QString::number(height)));
 }
 
@@ -796,9 +799,20 @@ void MainWindow::onConnectionStatusChanged(int status)
     }
 
     m_statusBtnConnectionStatusIndicator->setIcon(icon);
+
+    // Sync metrics are only sampled while connecting or synchronizing, don't leave the last rate on display
+    this->updateNetStats();
 }
 
 void MainWindow::onTransactionCreated(PendingTransaction *tx, const QVector<QString> &address) {
+    // Tell whoever created the transaction when it doesn't get sent, e.g. the remaining batches of a payout
+    bool confirmed = false;
+    const auto cancelled = sg::make_scope_guard([this, createdTx = tx, &confirmed]() noexcept {
+        if (!confirmed) {
+            emit m_wallet->transactionCancelled(createdTx);
+        }
+    });
+
     // Clean up some UI
     m_constructingTransaction = false;
     m_txTimer.stop();
@@ -998,7 +1012,7 @@ void MainWindow::onTransactionCreated(PendingTransaction *tx, const QVector<QStr
     if (address.size() > 1) {
         TxConfAdvDialog dialog_adv{m_wallet, m_wallet->tmpTxDescription, this};
         dialog_adv.setTransaction(tx, !m_wallet->viewOnly());
-        dialog_adv.exec();
+        confirmed = (dialog_adv.exec() == QDialog::Accepted);
         return;
     }
 
@@ -1012,6 +1026,7 @@ void MainWindow::onTransactionCreated(PendingTransaction *tx, const QVector<QStr
             break;
         }
         case QDialog::Accepted:
+            confirmed = true;
             m_wallet->commitTransaction(tx, m_wallet->tmpTxDescription);
             break;
     }
@@ -1019,7 +1034,7 @@ void MainWindow::onTransactionCreated(PendingTransaction *tx, const QVector<QStr
     if (dialog.showAdvanced) {
         TxConfAdvDialog dialog_adv{m_wallet, m_wallet->tmpTxDescription, this};
         dialog_adv.setTransaction(tx);
-        dialog_adv.exec();
+        confirmed = (dialog_adv.exec() == QDialog::Accepted);
     }
 }
 
@@ -1067,10 +1082,11 @@ void MainWindow::onTransactionCommitted(bool success, PendingTransaction *tx, co
     if (msgBox.clickedButton() == showDetailsButton) {
         this->showHistoryTab();
 
+        m_wallet->history()->ensureLoaded();
         const auto& rows = m_wallet->history()->getRows();
         auto itr = std::find_if(rows.begin(), rows.end(),
                 [&](const TransactionRow& ti) {
-            return ti.hash == txid.first();
+            return ti.hash() == txid.first();
         });
         if (itr == rows.end()) {
             return;
@@ -1212,6 +1228,11 @@ void MainWindow::menuVerifyTxProof() {
     dialog.exec();
 }
 
+void MainWindow::menuBatchProofs() {
+    ProofBatchDialog dialog{this, m_wallet};
+    dialog.exec();
+}
+
 void MainWindow::onShowSettingsPage(int page) {
     conf()->set(Config::lastSettingsPage, page);
     this->menuSettingsClicked();
@@ -1258,7 +1279,7 @@ void MainWindow::closeEvent(QCloseEvent *event) {
 
         m_historyWidget->resetModel();
 
-        m_updateBytes.stop();
+        m_wallet->syncMetrics()->disconnect(this);
         m_txTimer.stop();
 
         // Wallet signal may fire after AppContext is gone, causing segv
@@ -1302,7 +1323,12 @@ void MainWindow::payToMany() {
     Utils::showInfo(this, "Pay to many", "Enter a list of outputs in the 'Pay to' field.\n"
                                          "One output per line.\n"
                                          "Format: address, amount\n"
-                                         "A maximum of 16 addresses may be specified.");
+                                         "More than 15 outputs are sent in multiple transactions.");
+}
+
+void MainWindow::importPayouts() {
+    ui->tabWidget->setCurrentIndex(this->findTab("Send"));
+    m_sendWidget->importPayouts();
 }
 
 void MainWindow::onViewOnBlockExplorer(const QString &txid) {
@@ -1361,6 +1387,14 @@ void MainWindow::showTxPoolViewerDialog() {
     m_txPoolViewerDialog->show();
 }
 
+void MainWindow::showSyncOverviewDialog() {
+    if (!m_syncOverviewDialog) {
+        m_syncOverviewDialog = new SyncOverviewDialog{this};
+    }
+
+    m_syncOverviewDialog->show();
+}
+
 void MainWindow::showAccountSwitcherDialog() {
     m_accountSwitcherDialog->show();
     m_accountSwitcherDialog->update();
@@ -1533,15 +1567,26 @@ void MainWindow::onWalletPassphraseNeeded(bool on_device) {
 }
 
 void MainWindow::updateNetStats() {
-    if (!m_wallet || m_wallet->connectionStatus() == Wallet::ConnectionStatus_Disconnected
-                       || m_wallet->connectionStatus() == Wallet::ConnectionStatus_Synchronized)
+    if (!m_wallet || (m_wallet->connectionStatus() != Wallet::ConnectionStatus_Connecting
+                       && m_wallet->connectionStatus() != Wallet::ConnectionStatus_Synchronizing))
     {
         m_statusLabelNetStats->hide();
         return;
     }
 
     m_statusLabelNetStats->show();
-    m_statusLabelNetStats->setText(QString("(D: %1)").arg(Utils::formatBytes(m_wallet->getBytesReceived())));
+
+    SyncMetrics *metrics = m_wallet->syncMetrics();
+    QString netStats = QString("D: %1").arg(Utils::formatBytes(m_wallet->getBytesReceived()));
+    double bytesPerSecond = metrics->bytesPerSecond();
+    if (bytesPerSecond > 0) {
+        netStats += QString(", %1/s").arg(Utils::formatBytes(bytesPerSecond));
+    }
+    double blocksPerSecond = metrics->blocksPerSecond();
+    if (blocksPerSecond > 0) {
+        netStats += QString(", %1 blocks/s").arg(QString::number(blocksPerSecond, 'f', 1));
+    }
+    m_statusLabelNetStats->setText(QString("(%1)").arg(netStats));
 }
 
 void MainWindow::rescanSpent() {
@@ -1676,6 +1721,7 @@ void MainWindow::onSelectedInputsChanged(const QStringList &selectedInputs) {
     ui->frame_coinControl->setVisible(numInputs > 0);
 
     if (numInputs > 0) {
+        m_wallet->coins()->ensureLoaded();
         quint64 totalAmount = m_wallet->coins()->sumAmounts(selectedInputs);
 
         QString text = QString("Coin control active: %1 selected outputs, %2 XMR").arg(QString::number(numInputs), WalletManager::displayAmount(totalAmount));
@@ -1927,6 +1973,19 @@ void MainWindow::toggleSearchbar(bool visible) {
         m_coinsWidget->focusSearchbar();
 }
 
+void MainWindow::loadTab(int index) {
+    if (index < 0) {
+        return;
+    }
+
+    if (index == this->findTab("History")) {
+        m_wallet->history()->load();
+    }
+    else if (index == this->findTab("Coins")) {
+        m_wallet->coins()->load();
+    }
+}
+
 int MainWindow::findTab(const QString &title) {
     for (int i = 0; i < ui->tabWidget->count(); i++) {
         if (ui->tabWidget->tabText(i) == title) {
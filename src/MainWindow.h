@@ -19,6 +19,7 @@
 #include "dialog/KeysDialog.h"
 #include "dialog/AboutDialog.h"
 #include "dialog/SplashDialog.h"
+#include "dialog/SyncOverviewDialog.h"
 #include "dialog/TxPoolViewerDialog.h"
 #include "libwalletqt/Wallet.h"
 #include "model/SubaddressModel.h"
@@ -108,6 +109,7 @@ private slots:
     void menuAboutClicked();
     void menuSignVerifyClicked();
     void menuVerifyTxProof();
+    void menuBatchProofs();
     void menuWalletCloseClicked();
     void menuProxySettingsClicked();
     void menuToggleTabVisible(const QString &key);
@@ -148,11 +150,13 @@ private slots:
     void showKeyImageSyncWizard();
     void showWalletCacheDebugDialog();
     void showTxPoolViewerDialog();
+    void showSyncOverviewDialog();
     void showAccountSwitcherDialog();
     void showAddressChecker();
     void showURDialog();
     
     void payToMany();
+    void importPayouts();
     void showHistoryTab();
     void skinChanged(const QString &skinName);
     void onViewOnBlockExplorer(const QString &txid);
@@ -208,6 +212,7 @@ private:
     void lockWallet();
     void unlockWallet(const QString &password);
     void closeQDialogChildren(QObject *object);
+    void loadTab(int index);
     int findTab(const QString &title);
 
     QIcon hardwareDevicePairedIcon();
@@ -222,6 +227,7 @@ private:
     SplashDialog *m_splashDialog = nullptr;
     AccountSwitcherDialog *m_accountSwitcherDialog = nullptr;
     TxPoolViewerDialog *m_txPoolViewerDialog = nullptr;
+    SyncOverviewDialog *m_syncOverviewDialog = nullptr;
 
     WalletUnlockWidget *m_walletUnlockWidget = nullptr;
     ContactsWidget *m_contactsWidget = nullptr;
@@ -248,7 +254,6 @@ private:
     QSignalMapper *m_tabShowHideSignalMapper;
     QMap<QString, ToggleTab*> m_tabShowHideMapper;
 
-    QTimer m_updateBytes;
     QTimer m_checkUserActivity;
 
     QList<Plugin*> m_plugins;
@@ -159,9 +159,7 @@ void ReceiveWidget::showContextMenu(const QPoint &point) {
         if (!index.isValid()) {
             return;
         }
-        auto& row = m_model->entryFromIndex(index);
-
-        m_wallet->subaddress()->setPinned(row.address, toggled);
+        m_wallet->subaddress()->setPinned(index.row(), toggled);
         m_proxyModel->invalidate();
     });
     actionPin->setCheckable(true);
@@ -172,9 +170,7 @@ void ReceiveWidget::showContextMenu(const QPoint &point) {
         if (!index.isValid()) {
             return;
         }
-        auto& row = m_model->entryFromIndex(index);
-
-        m_wallet->subaddress()->setHidden(row.address, toggled);
+        m_wallet->subaddress()->setHidden(index.row(), toggled);
         m_proxyModel->invalidate();
     });
     actionHide->setCheckable(true);
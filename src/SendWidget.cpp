@@ -9,8 +9,22 @@
 #include "utils/AppData.h"
 #include "utils/config.h"
 #include "Icons.h"
+#include "libwalletqt/AddressBook.h"
+#include "libwalletqt/FeeEstimator.h"
+#include "libwalletqt/TransactionBatcher.h"
 #include "libwalletqt/Wallet.h"
 #include "libwalletqt/WalletManager.h"
+#include "libwalletqt/PendingTransaction.h"
+
+#include <QAbstractItemView>
+#include <QMessageBox>
+
+namespace {
+    // One output is reserved for change
+    constexpr qsizetype MAX_DESTINATIONS_PER_TX = 15;
+
+    constexpr qsizetype MAX_CONTACT_COMPLETIONS = 10;
+}
 
 #if defined(WITH_SCANNER)
 #include "wizard/offline_tx_signing/OfflineTxSigningWizard.h"
@@ -22,9 +36,18 @@ SendWidget::SendWidget(Wallet *wallet, QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::SendWidget)
     , m_wallet(wallet)
+    , m_contactCompleter(new QCompleter(this))
+    , m_contactCompletions(new QStringListModel(this))
+    , m_batcher(new TransactionBatcher(wallet, this))
 {
     ui->setupUi(this);
 
+    m_contactCompleter->setModel(m_contactCompletions);
+    m_contactCompleter->setWidget(ui->lineAddress);
+    m_contactCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    m_contactCompleter->setWrapAround(false);
+    connect(m_contactCompleter, QOverload<const QModelIndex &>::of(&QCompleter::activated), this, &SendWidget::onContactCompleted);
+
     QString amount_rx = R"(^\d{0,8}[\.,]\d{0,12}|(all)$)";
     QRegularExpression rx;
     rx.setPattern(amount_rx);
@@ -34,6 +57,7 @@ SendWidget::SendWidget(Wallet *wallet, QWidget *parent)
     connect(m_wallet, &Wallet::transactionCreated, this, &SendWidget::enableSendButton);
     connect(m_wallet, &Wallet::beginCommitTransaction, this, &SendWidget::disableSendButton);
     connect(m_wallet, &Wallet::transactionCommitted, this, &SendWidget::enableSendButton);
+    connect(m_batcher, &TransactionBatcher::abandoned, this, &SendWidget::onBatchesAbandoned);
 
     connect(WalletManager::instance(), &WalletManager::openAliasResolved, this, &SendWidget::onOpenAliasResolved);
 
@@ -44,8 +68,12 @@ SendWidget::SendWidget(Wallet *wallet, QWidget *parent)
     connect(ui->comboCurrencySelection, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SendWidget::currencyComboChanged);
     connect(ui->lineAmount, &QLineEdit::textChanged, this, &SendWidget::amountEdited);
     connect(ui->lineAddress, &QPlainTextEdit::textChanged, this, &SendWidget::addressEdited);
+    connect(ui->lineAddress, &QPlainTextEdit::textChanged, this, &SendWidget::updateContactCompletions);
     connect(ui->btn_openAlias, &QPushButton::clicked, this, &SendWidget::aliasClicked);
     connect(ui->lineAddress, &PayToEdit::dataPasted, this, &SendWidget::onDataFromQR);
+    connect(ui->lineAddress, &PayToEdit::validationFinished, this, &SendWidget::addressEdited);
+    connect(ui->combo_feePriority, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SendWidget::updateFeeEstimate);
+    connect(m_wallet->feeEstimator(), &FeeEstimator::estimateUpdated, this, &SendWidget::updateFeeEstimate);
     ui->label_conversionAmount->setText("");
     ui->label_conversionAmount->hide();
     ui->btn_openAlias->hide();
@@ -96,6 +124,41 @@ void SendWidget::addressEdited() {
     ui->btn_openAlias->setVisible(ui->lineAddress->isOpenAlias());
 }
 
+void SendWidget::updateContactCompletions() {
+    QString text = ui->lineAddress->text();
+    if (!ui->lineAddress->hasFocus() || text.isEmpty() || ui->lineAddress->isMultiline() || !ui->lineAddress->getOutputs().empty()) {
+        m_contactCompleter->popup()->hide();
+        return;
+    }
+
+    QStringList descriptions;
+    m_contactAddresses.clear();
+    AddressBook *addressBook = m_wallet->addressBook();
+    for (qsizetype index : addressBook->findByDescriptionPrefix(text)) {
+        const ContactRow &row = addressBook->getRow(index);
+        descriptions.append(row.label);
+        m_contactAddresses.append(row.address);
+        if (descriptions.size() == MAX_CONTACT_COMPLETIONS) {
+            break;
+        }
+    }
+
+    if (descriptions.isEmpty()) {
+        m_contactCompleter->popup()->hide();
+        return;
+    }
+
+    m_contactCompletions->setStringList(descriptions);
+    m_contactCompleter->complete(ui->lineAddress->cursorRect());
+}
+
+void SendWidget::onContactCompleted(const QModelIndex &index) {
+    if (index.row() < 0 || index.row() >= m_contactAddresses.size()) {
+        return;
+    }
+    this->fill(m_contactAddresses[index.row()], index.data().toString(), 0, false);
+}
+
 void SendWidget::amountEdited(const QString &text) {
     Q_UNUSED(text)
     this->updateConversionLabel();
@@ -161,6 +224,11 @@ void SendWidget::sendClicked() {
         return;
     }
 
+    if (ui->lineAddress->isValidating()) {
+        Utils::showError(this, "Unable to create transaction", "Addresses are still being validated", {"Wait a moment and try again."}, "pay_to_many");
+        return;
+    }
+
     QVector<PartialTxOutput> outputs = ui->lineAddress->getOutputs();
     QVector<PayToLineError> errors = ui->lineAddress->getErrors();
     if (!errors.empty() && ui->lineAddress->isMultiline()) {
@@ -178,32 +246,37 @@ void SendWidget::sendClicked() {
     QString description = ui->lineDescription->text();
 
     if (!outputs.empty()) { // multi destination transaction
-        if (outputs.size() > 15) {
-            Utils::showError(this, "Unable to create transaction", "Maximum number of outputs (15) exceeded.", {}, "pay_to_many");
-            return;
+        // PayToEdit only returns outputs with valid addresses, no need to check them again
+        m_batches.clear();
+        for (qsizetype i = 0; i < outputs.size(); i += MAX_DESTINATIONS_PER_TX) {
+            m_batches.append(outputs.mid(i, MAX_DESTINATIONS_PER_TX));
         }
+        qsizetype batchCount = m_batches.size();
+        m_batchDescription = description;
+        m_batchSubtractFee = subtractFeeFromAmount;
+
+        if (batchCount > 1) {
+            if (m_wallet->viewOnly()) {
+                m_batches.clear();
+                Utils::showError(this, "Unable to create transaction", QString("Maximum number of outputs (%1) exceeded.").arg(MAX_DESTINATIONS_PER_TX),
+                                 {"Split the payouts into multiple transactions."}, "pay_to_many");
+                return;
+            }
 
-        QVector<QString> addresses;
-        QVector<quint64> amounts;
-        for (auto &output : outputs) {
-            // Validate each address in multi-destination transaction
-            if (!WalletManager::addressValid(output.address, constants::networkType)) {
-                Utils::showError(this, "Invalid Address",
-                    QString("Invalid Monero address: %1").arg(output.address.left(20) + "..."),
-                    {}, "pay_to_many");
+            auto result = QMessageBox::question(this, "Pay to many",
+                                                QString("%1 outputs do not fit in a single transaction.\n\n"
+                                                        "They will be sent in %2 transactions of at most %3 outputs, "
+                                                        "each of which you will be asked to confirm.\n\nContinue?")
+                                                        .arg(QString::number(outputs.size()), QString::number(batchCount), QString::number(MAX_DESTINATIONS_PER_TX)));
+            if (result != QMessageBox::Yes) {
+                m_batches.clear();
                 return;
             }
-            addresses.push_back(output.address);
-            amounts.push_back(output.amount);
         }
 
-        QtFuture::connect(m_wallet, &Wallet::preTransactionChecksComplete)
-                .then([this, addresses, amounts, description, subtractFeeFromAmount](int feeLevel){
-                    m_wallet->createTransactionMultiDest(addresses, amounts, description, feeLevel, subtractFeeFromAmount);
-                });
-
-        m_wallet->preTransactionChecks(ui->combo_feePriority->currentIndex());
-
+        m_batcher->start(batchCount, [this](qsizetype index){
+            return this->createBatch(index);
+        });
         return;
     }
 
@@ -271,6 +344,8 @@ void SendWidget::aliasClicked() {
 }
 
 void SendWidget::clearClicked() {
+    m_batcher->stop();
+    m_batches.clear();
     ui->lineAddress->clear();
     ui->lineAmount->clear();
     ui->lineDescription->clear();
@@ -369,6 +444,75 @@ void SendWidget::payToMany() {
     ui->lineAddress->payToMany();
 }
 
+void SendWidget::importPayouts() {
+    QString fn = Utils::getOpenFileName(this, "Import payouts", "Payout files (*.csv *.json);;All Files (*)");
+    if (fn.isEmpty()) {
+        return;
+    }
+
+    QStringList lines;
+    QString error;
+    if (!PayToEdit::parsePayouts(Utils::fileOpen(fn), lines, error)) {
+        Utils::showError(this, "Unable to import payouts", error, {}, "pay_to_many");
+        return;
+    }
+
+    if (lines.isEmpty()) {
+        Utils::showError(this, "Unable to import payouts", "No payouts found in file", {}, "pay_to_many");
+        return;
+    }
+
+    ui->lineAddress->setText(lines.join("\n"));
+    ui->lineAddress->moveCursor(QTextCursor::Start);
+}
+
+bool SendWidget::createBatch(qsizetype index) {
+    QVector<QString> addresses;
+    QVector<quint64> amounts;
+    for (const auto &output : m_batches[index]) {
+        addresses.push_back(output.address.trimmed());
+        amounts.push_back(output.amount);
+    }
+
+    QString description = m_batchDescription;
+    if (m_batches.size() > 1) {
+        description = QString("%1 (%2/%3)").arg(m_batchDescription, QString::number(index + 1), QString::number(m_batches.size())).trimmed();
+    }
+
+    bool subtractFeeFromAmount = m_batchSubtractFee;
+    QtFuture::connect(m_wallet, &Wallet::preTransactionChecksComplete)
+            .then([this, addresses, amounts, description, subtractFeeFromAmount](int feeLevel){
+                m_wallet->createTransactionMultiDest(addresses, amounts, description, feeLevel, subtractFeeFromAmount);
+            });
+
+    m_wallet->preTransactionChecks(ui->combo_feePriority->currentIndex());
+    return true;
+}
+
+void SendWidget::onBatchesAbandoned(qsizetype sent, qsizetype count, const QString &reason) {
+    // Put the outputs that were not paid back in the 'Pay to' field, so paying them again can't pay anyone twice
+    QStringList unpaid;
+    for (qsizetype i = sent; i < m_batches.size(); i++) {
+        for (const auto &output : m_batches[i]) {
+            unpaid.append(QString("%1, %2").arg(output.address.trimmed(), WalletManager::displayAmount(output.amount, false)));
+        }
+    }
+    m_batches.clear();
+
+    ui->lineAddress->setText(unpaid.join("\n"));
+    ui->lineAddress->moveCursor(QTextCursor::Start);
+
+    constexpr qsizetype MAX_LISTED = 10;
+    QString list = unpaid.mid(0, MAX_LISTED).join("\n");
+    if (unpaid.size() > MAX_LISTED) {
+        list += QString("\n… and %1 more").arg(QString::number(unpaid.size() - MAX_LISTED));
+    }
+
+    Utils::showError(this, "Pay to many interrupted",
+                     QString("%1 of %2 transactions were sent.\n\n%3\n\nUnpaid outputs:\n%4").arg(QString::number(sent), QString::number(count), reason, list),
+                     {"The 'Pay to' field now only contains the unpaid outputs."}, "pay_to_many");
+}
+
 void SendWidget::disableSendButton() {
     ui->btnSend->setEnabled(false);
 }
@@ -398,6 +542,22 @@ void SendWidget::setWebsocketEnabled(bool enabled) {
 void SendWidget::setManualFeeSelectionEnabled(bool enabled) {
     ui->label_feeTarget->setVisible(enabled);
     ui->combo_feePriority->setVisible(enabled);
+    ui->label_feeEstimate->setVisible(enabled);
+}
+
+void SendWidget::updateFeeEstimate() {
+    qint64 blocks = m_wallet->feeEstimator()->blocksForFeeLevel(ui->combo_feePriority->currentIndex());
+    if (blocks < 0) {
+        ui->label_feeEstimate->clear();
+        return;
+    }
+
+    if (blocks == 0) {
+        ui->label_feeEstimate->setText("Expected in next block");
+        return;
+    }
+
+    ui->label_feeEstimate->setText(QString("Backlog of %1 blocks (≈ %2 minutes)").arg(QString::number(blocks), QString::number(blocks * 2)));
 }
 
 void SendWidget::setSubtractFeeFromAmountEnabled(bool enabled) {
@@ -4,8 +4,13 @@
 #ifndef FEATHER_SENDWIDGET_H
 #define FEATHER_SENDWIDGET_H
 
+#include <QCompleter>
+#include <QStringListModel>
 #include <QWidget>
 
+#include "widgets/PayToEdit.h"
+
+class TransactionBatcher;
 class Wallet;
 
 namespace Ui {
@@ -22,6 +27,7 @@ public:
     void fill(double amount);
     void clearFields();
     void payToMany();
+    void importPayouts();
     ~SendWidget() override;
 
 public slots:
@@ -41,6 +47,7 @@ public slots:
     void setWebsocketEnabled(bool enabled);
 
     void setManualFeeSelectionEnabled(bool enabled);
+    void updateFeeEstimate();
     void setSubtractFeeFromAmountEnabled(bool enabled);
 
     void disableSendButton();
@@ -50,8 +57,13 @@ public slots:
 
 private slots:
     void onDataFromQR(const QString &data);
+    void updateContactCompletions();
+    void onContactCompleted(const QModelIndex &index);
 
 private:
+    bool createBatch(qsizetype index);
+    void onBatchesAbandoned(qsizetype sent, qsizetype count, const QString &reason);
+
     void setupComboBox();
     double amountDouble();
     bool keyImageSync(bool sendAll, quint64 amount);
@@ -62,6 +74,17 @@ private:
     QScopedPointer<Ui::SendWidget> ui;
     Wallet *m_wallet;
     bool m_disallowSending = false;
+
+    // Contacts whose name starts with what was typed into the pay to field
+    QCompleter *m_contactCompleter;
+    QStringListModel *m_contactCompletions;
+    QStringList m_contactAddresses;
+
+    // Payouts with more outputs than fit in a transaction are sent in batches, one after the other
+    TransactionBatcher *m_batcher;
+    QList<QVector<PartialTxOutput>> m_batches;
+    QString m_batchDescription;
+    bool m_batchSubtractFee = false;
 };
 
 #endif // FEATHER_SENDWIDGET_H
@@ -364,6 +364,12 @@ void Settings::setupTransactionsTab() {
         conf()->set(Config::subtractFeeFromAmount, toggled);
         emit subtractFeeFromAmountEnabled(toggled);
     });
+
+    ui->checkBox_minimizeFeeInputSelection->setChecked(conf()->get(Config::minimizeFeeInputSelection).toBool());
+    ui->checkBox_minimizeFeeInputSelection->setToolTip("Applies when no coins are selected in the Coins tab.");
+    connect(ui->checkBox_minimizeFeeInputSelection, &QCheckBox::toggled, [](bool toggled){
+        conf()->set(Config::minimizeFeeInputSelection, toggled);
+    });
 }
 
 void Settings::setupPluginsTab() {
@@ -6,6 +6,7 @@
 #include <QDialogButtonBox>
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QTimer>
 #include <QWindow>
 
 #include "Application.h"
@@ -15,6 +16,7 @@
 #include "dialog/PasswordDialog.h"
 #include "dialog/SplashDialog.h"
 #include "dialog/TorInfoDialog.h"
+#include "libwalletqt/SyncScheduler.h"
 #include "libwalletqt/WalletManager.h"
 #include "libwalletqt/Wallet.h"
 #include "utils/Icons.h"
@@ -30,7 +32,11 @@ WindowManager::WindowManager(QObject *parent)
 {
     m_walletManager = WalletManager::instance();
     m_splashDialog = new SplashDialog();
-    m_cleanupThread = new QThread(this);
+
+    const int cleanupThreads = qBound(2, QThread::idealThreadCount(), 8);
+    for (int i = 0; i < cleanupThreads; i++) {
+        m_cleanupThreads.append(new QThread(this));
+    }
 
     connect(m_walletManager, &WalletManager::walletOpened,        this, &WindowManager::onWalletOpened);
     connect(m_walletManager, &WalletManager::walletCreated,       this, &WindowManager::onWalletCreated);
@@ -41,6 +47,7 @@ WindowManager::WindowManager(QObject *parent)
 
     connect(qApp, SIGNAL(anotherInstanceStarted()), this, SLOT(raise()));
     connect(qApp, &QGuiApplication::lastWindowClosed, this, &WindowManager::quitAfterLastWindow);
+    connect(qApp, &QGuiApplication::focusWindowChanged, this, &WindowManager::onFocusWindowChanged);
 
     m_tray = new QSystemTrayIcon(icons()->icon("appicons/64x64.png"));
     m_tray->setToolTip("Feather Wallet");
@@ -71,9 +78,11 @@ void WindowManager::setEventFilter(EventFilter *ef) {
 
 WindowManager::~WindowManager() {
     qDebug() << "~WindowManager";
-    m_cleanupThread->quit();
-    m_cleanupThread->wait();
-    qDebug() << "WindowManager: cleanup thread done" << QThread::currentThreadId();
+    for (const auto &thread : m_cleanupThreads) {
+        thread->quit();
+        thread->wait();
+    }
+    qDebug() << "WindowManager: cleanup threads done" << QThread::currentThreadId();
 }
 
 // ######################## APPLICATION LIFECYCLE ########################
@@ -87,6 +96,16 @@ void WindowManager::quitAfterLastWindow() {
     this->close();
 }
 
+void WindowManager::onFocusWindowChanged() {
+    // The wallet in the window the user is looking at refreshes ahead of the others
+    for (const auto &window : m_windows) {
+        if (window->isActiveWindow()) {
+            syncScheduler()->setFocusedWallet(window->m_wallet);
+            return;
+        }
+    }
+}
+
 void WindowManager::close() {
     qDebug() << Q_FUNC_INFO << QThread::currentThreadId();
     for (const auto &window: m_windows) {
@@ -108,6 +127,21 @@ void WindowManager::close() {
 
     torManager()->stop();
 
+    m_quitting = true;
+    if (!m_closingWallets.isEmpty()) {
+        // Don't quit before all wallets are stored, only bother the user if it takes a while
+        QTimer::singleShot(300, this, &WindowManager::updateCloseProgress);
+        return;
+    }
+
+    this->finishQuit();
+}
+
+void WindowManager::finishQuit() {
+    if (m_closeProgress) {
+        m_closeProgress->deleteLater();
+    }
+
     deleteLater();
 
     qDebug() << "Calling QApplication::quit()";
@@ -118,14 +152,77 @@ void WindowManager::closeWindow(MainWindow *window) {
     qDebug() << "WindowManager: closing Window";
     m_windows.removeOne(window);
 
+    Wallet *wallet = window->m_wallet;
+
+    // Interrupt the refresh right away, the wallet is destroyed once its cleanup thread gets to it
+    wallet->beginClose();
+
     // Move Wallet to a different thread for cleanup, so it doesn't block GUI thread
-    window->m_wallet->moveToThread(m_cleanupThread);
-    m_cleanupThread->start();
-    window->m_wallet->deleteLater();
+    QThread *thread = m_cleanupThreads.first();
+    int load = -1;
+    for (const auto &candidate : m_cleanupThreads) {
+        int candidateLoad = 0;
+        for (const auto &closing : m_closingWallets) {
+            candidateLoad += (closing.thread == candidate);
+        }
+        if (load < 0 || candidateLoad < load) {
+            thread = candidate;
+            load = candidateLoad;
+        }
+    }
+
+    m_closingWallets.insert(wallet, {wallet->walletName(), thread});
+    connect(wallet, &QObject::destroyed, this, &WindowManager::onWalletClosed);
+
+    wallet->moveToThread(thread);
+    thread->start();
+    wallet->deleteLater();
 
     window->deleteLater();
 }
 
+void WindowManager::onWalletClosed(QObject *wallet) {
+    // The wallet is already destroyed, only use it as a key
+    m_closingWallets.remove(wallet);
+
+    if (!m_quitting) {
+        return;
+    }
+
+    if (m_closingWallets.isEmpty()) {
+        this->finishQuit();
+        return;
+    }
+
+    if (m_closeProgress) {
+        this->updateCloseProgress();
+    }
+}
+
+void WindowManager::updateCloseProgress() {
+    if (m_closingWallets.isEmpty()) {
+        return;
+    }
+
+    if (!m_closeProgress) {
+        m_closeProgress = new QProgressDialog();
+        m_closeProgress->setWindowTitle("Feather");
+        m_closeProgress->setCancelButton(nullptr);
+        m_closeProgress->setMinimumDuration(0);
+        m_closeProgress->setRange(0, m_closingWallets.size());
+    }
+
+    QStringList names;
+    for (const auto &closing : m_closingWallets) {
+        names.append(closing.name);
+    }
+    names.sort();
+
+    m_closeProgress->setLabelText(QString("Saving wallets, please wait…\n\n%1").arg(names.join("\n")));
+    m_closeProgress->setValue(m_closeProgress->maximum() - m_closingWallets.size());
+    m_closeProgress->show();
+}
+
 void WindowManager::restartApplication(const QString &binaryFilename) {
     QProcess::startDetached(binaryFilename, qApp->arguments());
     this->close();
@@ -277,6 +374,7 @@ void WindowManager::tryOpenWallet(const QString &path, const QString &password)
     }
 
     m_openingWallet = true;
+    m_openWalletTimer.start();
     m_walletManager->openWalletAsync(path, password, constants::networkType, constants::kdfRounds, Utils::ringDatabasePath());
 }
 
@@ -321,6 +419,10 @@ void WindowManager::onWalletOpened(Wallet *wallet) {
         return;
     }
 
+    if (m_openWalletTimer.isValid()) {
+        qInfo() << "Wallet open: wallet loaded in" << m_openWalletTimer.elapsed() << "ms";
+    }
+
     this->onInitialNetworkConfigured();
 
     // Create new mainwindow with wallet
@@ -331,6 +433,11 @@ void WindowManager::onWalletOpened(Wallet *wallet) {
     m_windows.append(window);
     this->buildTrayMenu();
     m_openingWallet = false;
+
+    if (m_openWalletTimer.isValid()) {
+        qInfo() << "Wallet open: main window ready in" << m_openWalletTimer.elapsed() << "ms";
+        m_openWalletTimer.invalidate();
+    }
 }
 
 void WindowManager::onWalletOpenPasswordRequired(bool invalidPassword, const QString &path) {
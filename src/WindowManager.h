@@ -4,7 +4,10 @@
 #ifndef FEATHER_WINDOWMANAGER_H
 #define FEATHER_WINDOWMANAGER_H
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <QPointer>
+#include <QProgressDialog>
 #include <QSystemTrayIcon>
 
 #include "utils/EventFilter.h"
@@ -71,6 +74,7 @@ private slots:
     void onDeviceError(const QString &errorMessage, quint64 errorCode);
     void onWalletPassphraseNeeded(bool on_device);
     void onChangeTheme(const QString &themeName);
+    void onFocusWindowChanged();
 
 private:
     void tryCreateWallet(Seed seed, const QString &path, const QString &password, const QString &seedLanguage, const QString &seedOffset, const QString &subaddressLookahead, bool newWallet);
@@ -96,6 +100,9 @@ private:
     void showCrashLogs();
 
     void quitAfterLastWindow();
+    void onWalletClosed(QObject *wallet);
+    void updateCloseProgress();
+    void finishQuit();
 
     static QPointer<WindowManager> m_instance;
 
@@ -112,9 +119,21 @@ private:
 
     bool m_openWalletTriedOnce = false;
     bool m_openingWallet = false;
+    QElapsedTimer m_openWalletTimer; // startup phase timings
     bool m_initialNetworkConfigured = false;
 
-    QThread *m_cleanupThread;
+    // Wallets are stored and destroyed on these threads, so closing a wallet doesn't block the GUI thread and wallets
+    // that close at the same time are saved in parallel
+    QVector<QThread*> m_cleanupThreads;
+
+    struct ClosingWallet {
+        QString name;
+        QThread *thread;
+    };
+    QHash<QObject*, ClosingWallet> m_closingWallets;
+
+    bool m_quitting = false;
+    QPointer<QProgressDialog> m_closeProgress;
 };
 
 inline WindowManager* windowManager()
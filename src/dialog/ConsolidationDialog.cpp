@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "ConsolidationDialog.h"
+#include "ui_ConsolidationDialog.h"
+
+#include <QPushButton>
+#include <QTreeWidgetItem>
+
+#include <algorithm>
+
+#include "libwalletqt/WalletManager.h"
+
+ConsolidationDialog::ConsolidationDialog(Wallet *wallet, QWidget *parent)
+        : WindowModalDialog(parent)
+        , ui(new Ui::ConsolidationDialog)
+        , m_wallet(wallet)
+{
+    ui->setupUi(this);
+
+    ui->tree_batches->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    ui->tree_batches->header()->setStretchLastSection(true);
+
+    ui->buttonBox->button(QDialogButtonBox::Ok)->setText("Consolidate");
+
+    connect(m_wallet, &Wallet::consolidationPlanned, this, &ConsolidationDialog::onPlanned);
+
+    connect(ui->spinBox_maxInputs, QOverload<int>::of(&QSpinBox::valueChanged), this, &ConsolidationDialog::replan);
+    connect(ui->combo_feePriority, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ConsolidationDialog::replan);
+    connect(ui->checkBox_mergeSubaddresses, &QCheckBox::toggled, this, &ConsolidationDialog::replan);
+
+    connect(ui->buttonBox, &QDialogButtonBox::accepted, [this]{
+        // Only accept the plan that matches the current settings
+        if (m_pendingPlans > 0 || m_plan.batches.isEmpty()) {
+            return;
+        }
+        this->accept();
+    });
+
+    this->replan();
+    this->adjustSize();
+}
+
+const ConsolidationPlan& ConsolidationDialog::plan() const {
+    return m_plan;
+}
+
+int ConsolidationDialog::feeLevel() const {
+    return ui->combo_feePriority->currentIndex();
+}
+
+bool ConsolidationDialog::waitForLowBacklog() const {
+    return ui->checkBox_waitForBacklog->isChecked();
+}
+
+void ConsolidationDialog::replan() {
+    m_pendingPlans += 1;
+    ui->buttonBox->button(QDialogButtonBox::Ok)->setEnabled(false);
+    ui->label_summary->setText("Planning…");
+
+    m_wallet->planConsolidation(ui->spinBox_maxInputs->value(), ui->checkBox_mergeSubaddresses->isChecked(),
+                                ui->combo_feePriority->currentIndex());
+}
+
+void ConsolidationDialog::onPlanned(const ConsolidationPlan &plan) {
+    // Plans can finish out of order, wait for the last one
+    m_pendingPlans = std::max(0, m_pendingPlans - 1);
+    if (m_pendingPlans > 0) {
+        return;
+    }
+
+    m_plan = plan;
+
+    ui->tree_batches->clear();
+    for (int i = 0; i < plan.batches.size(); i++) {
+        const ConsolidationBatch &batch = plan.batches[i];
+
+        auto *item = new QTreeWidgetItem(ui->tree_batches);
+        item->setText(0, QString::number(i + 1));
+        item->setText(1, QString::number(batch.keyImages.size()));
+        item->setText(2, WalletManager::displayAmount(batch.amount));
+        item->setText(3, WalletManager::displayAmount(batch.estimatedFee));
+        item->setText(4, batch.subaddrIndex == 0 ? "Primary address" : QString("Subaddress #%1").arg(batch.subaddrIndex));
+    }
+
+    if (plan.batches.isEmpty()) {
+        ui->label_summary->setText(QString("Nothing to consolidate: %1 spendable outputs, no two of them can be combined.").arg(plan.outputs));
+    }
+    else {
+        ui->label_summary->setText(QString("%1 inputs in %2 transaction(s), %3 outputs left afterwards. Estimated fees: %4 XMR.")
+                                           .arg(QString::number(plan.inputs()),
+                                                QString::number(plan.batches.size()),
+                                                QString::number(plan.outputs - plan.inputs() + plan.batches.size()),
+                                                WalletManager::displayAmount(plan.totalFee())));
+    }
+
+    if (plan.skippedDust > 0) {
+        ui->label_summary->setText(ui->label_summary->text() + QString("\n%1 outputs (%2 XMR) are worth less than the fee to spend them and are left alone.")
+                                           .arg(QString::number(plan.skippedDust), WalletManager::displayAmount(plan.dustAmount)));
+    }
+
+    if (plan.skippedSingles > 0) {
+        ui->label_summary->setText(ui->label_summary->text() + QString("\n%1 outputs (%2 XMR) are the only output of their subaddress and are left alone.")
+                                           .arg(QString::number(plan.skippedSingles), WalletManager::displayAmount(plan.singlesAmount)));
+    }
+
+    ui->buttonBox->button(QDialogButtonBox::Ok)->setEnabled(!plan.batches.isEmpty());
+}
+
+ConsolidationDialog::~ConsolidationDialog() = default;
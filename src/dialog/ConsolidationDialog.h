@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_CONSOLIDATIONDIALOG_H
+#define FEATHER_CONSOLIDATIONDIALOG_H
+
+#include <QDialog>
+
+#include "components.h"
+#include "libwalletqt/Wallet.h"
+
+namespace Ui {
+    class ConsolidationDialog;
+}
+
+class ConsolidationDialog : public WindowModalDialog
+{
+Q_OBJECT
+
+public:
+    explicit ConsolidationDialog(Wallet *wallet, QWidget *parent = nullptr);
+    ~ConsolidationDialog() override;
+
+    const ConsolidationPlan& plan() const;
+    int feeLevel() const;
+    bool waitForLowBacklog() const;
+
+private:
+    void replan();
+    void onPlanned(const ConsolidationPlan &plan);
+
+    QScopedPointer<Ui::ConsolidationDialog> ui;
+    Wallet *m_wallet;
+
+    ConsolidationPlan m_plan;
+    int m_pendingPlans = 0;
+};
+
+#endif //FEATHER_CONSOLIDATIONDIALOG_H
@@ -4,6 +4,9 @@
 #include "DebugInfoDialog.h"
 #include "ui_DebugInfoDialog.h"
 
+#include <QFileDialog>
+
+#include "libwalletqt/SyncMetrics.h"
 #include "utils/AppData.h"
 #include "utils/os/tails.h"
 #include "utils/os/whonix.h"
@@ -20,6 +23,7 @@ DebugInfoDialog::DebugInfoDialog(Wallet *wallet, Nodes *nodes, QWidget *parent)
     ui->setupUi(this);
 
     connect(ui->btn_Copy, &QPushButton::clicked, this, &DebugInfoDialog::copyToClipboard);
+    connect(ui->btn_exportTimeline, &QPushButton::clicked, this, &DebugInfoDialog::exportTimeline);
 
     m_updateTimer.start(5000);
     connect(&m_updateTimer, &QTimer::timeout, this, &DebugInfoDialog::updateInfo);
@@ -123,6 +127,34 @@ void DebugInfoDialog::updateInfo() {
     }
     ui->label_OS->setText(os);
     ui->label_timestamp->setText(QString::number(QDateTime::currentSecsSinceEpoch()));
+
+    SyncMetrics *metrics = m_wallet->syncMetrics();
+    ui->label_syncRate->setText(QString("%1 blocks/s, %2/s").arg(QString::number(metrics->blocksPerSecond(), 'f', 1),
+                                                                Utils::formatBytes(metrics->bytesPerSecond())));
+    qint64 eta = metrics->eta();
+    ui->label_syncEta->setText(eta >= 0 ? Utils::formatDuration(eta) : "N/A");
+    auto [refreshMsecs, modelMsecs] = metrics->timeBreakdown();
+    ui->label_syncTime->setText(QString("refresh %1 ms, models %2 ms (last %3s)").arg(QString::number(refreshMsecs),
+                                                                                      QString::number(modelMsecs),
+                                                                                      QString::number(SyncMetrics::WINDOW_MSECS / 1000)));
+}
+
+void DebugInfoDialog::exportTimeline() {
+    QString defaultName = QString("sync_timeline_%1.csv").arg(m_wallet->walletName());
+    QString filePath = QFileDialog::getSaveFileName(this, "Save CSV file", QDir::home().filePath(defaultName), "CSV (*.csv)");
+    if (filePath.isEmpty()) {
+        return;
+    }
+    if (!filePath.endsWith(".csv")) {
+        filePath += ".csv";
+    }
+
+    if (!Utils::fileWrite(filePath, m_wallet->syncMetrics()->timelineCsv())) {
+        Utils::showError(this, "Unable to export sync timeline", QString("Could not write to file: %1").arg(filePath));
+        return;
+    }
+
+    Utils::showInfo(this, "Sync timeline exported", QString("Saved to: %1").arg(filePath));
 }
 
 QString DebugInfoDialog::statusToString(Wallet::ConnectionStatus status) {
@@ -169,6 +201,10 @@ void DebugInfoDialog::copyToClipboard() {
     text += QString("Operating system: %1  \n").arg(ui->label_OS->text());
     text += QString("Timestamp: %1  \n").arg(ui->label_timestamp->text());
 
+    text += QString("Sync rate: %1  \n").arg(ui->label_syncRate->text());
+    text += QString("Sync ETA: %1  \n").arg(ui->label_syncEta->text());
+    text += QString("Sync time: %1  \n").arg(ui->label_syncTime->text());
+
     Utils::copyToClipboard(text);
 }
 
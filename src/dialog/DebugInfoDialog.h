@@ -25,6 +25,7 @@ public:
 private:
     QString statusToString(Wallet::ConnectionStatus status);
     void copyToClipboard();
+    void exportTimeline();
     void updateInfo();
 
     QScopedPointer<Ui::DebugInfoDialog> ui;
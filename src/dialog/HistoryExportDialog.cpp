@@ -90,6 +90,7 @@ void HistoryExportDialog::exportHistory()
         return;
     }
 
+    m_wallet->history()->ensureLoaded();
     auto num_transactions = m_wallet->history()->count();
 
     QList<QPair<uint64_t, QString>> csvData;
@@ -160,7 +161,7 @@ void HistoryExportDialog::exportHistory()
              balanceDelta,
              tx.displayAmount(),
              tx.displayFee(),
-             tx.hash,
+             tx.hash(),
              tx.description,
              paymentId,
              fiatAmount,
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "ProofBatchDialog.h"
+#include "ui_ProofBatchDialog.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include "utils/Utils.h"
+
+ProofBatchDialog::ProofBatchDialog(QWidget *parent, Wallet *wallet)
+        : WindowModalDialog(parent)
+        , ui(new Ui::ProofBatchDialog)
+        , m_wallet(wallet)
+{
+    ui->setupUi(this);
+
+    ui->progressBar->hide();
+    ui->btn_cancel->hide();
+
+    connect(ui->btn_browse, &QPushButton::clicked, this, &ProofBatchDialog::onBrowse);
+    connect(ui->btn_start, &QPushButton::clicked, this, &ProofBatchDialog::onStart);
+    connect(ui->btn_cancel, &QPushButton::clicked, this, &ProofBatchDialog::onCancel);
+
+    this->adjustSize();
+}
+
+void ProofBatchDialog::onBrowse() {
+    QString fn = Utils::getOpenFileName(this, "Select proofs", "CSV Files (*.csv);;All Files (*)");
+    if (fn.isEmpty()) {
+        return;
+    }
+    ui->line_file->setText(fn);
+}
+
+void ProofBatchDialog::onStart() {
+    if (m_batch) {
+        return;
+    }
+
+    QString fn = ui->line_file->text();
+    if (fn.isEmpty()) {
+        Utils::showError(this, "Unable to start", "No input file selected");
+        return;
+    }
+
+    if (!m_wallet->isConnected()) {
+        Utils::showError(this, "Unable to start", "Wallet is not connected to a node.", {}, "nodes");
+        return;
+    }
+
+    auto mode = static_cast<ProofBatch::Mode>(ui->combo_mode->currentIndex());
+    QList<ProofBatchEntry> entries;
+    QString error = ProofBatch::readCSV(fn, mode, entries);
+    if (!error.isEmpty()) {
+        Utils::showError(this, "Unable to read proofs", error);
+        return;
+    }
+
+    m_batch.reset(m_wallet->createProofBatch(mode, entries));
+    connect(m_batch.data(), &ProofBatch::progress, this, &ProofBatchDialog::onProgress);
+    connect(m_batch.data(), &ProofBatch::finished, this, &ProofBatchDialog::onFinished);
+
+    ui->progressBar->setRange(0, entries.size());
+    ui->progressBar->setValue(0);
+    ui->label_status->setText(QString("Fetching transactions for %1 proof(s)..").arg(entries.size()));
+    this->setRunning(true);
+
+    m_batch->start();
+}
+
+void ProofBatchDialog::onCancel() {
+    if (m_batch) {
+        m_batch->cancel();
+        ui->label_status->setText("Cancelling..");
+        ui->btn_cancel->setEnabled(false);
+    }
+}
+
+void ProofBatchDialog::onProgress(int done, int total) {
+    ui->progressBar->setValue(done);
+    ui->label_status->setText(QString("Processed %1 of %2 proof(s)").arg(QString::number(done), QString::number(total)));
+}
+
+void ProofBatchDialog::onFinished(bool success) {
+    this->setRunning(false);
+
+    if (!success) {
+        ui->label_status->setText("Cancelled");
+        m_batch.reset();
+        return;
+    }
+
+    int failed = 0;
+    int invalid = 0;
+    const auto results = m_batch->results();
+    for (const auto &entry : results) {
+        if (!entry.success) {
+            failed += 1;
+        } else if (m_batch->mode() == ProofBatch::Verify && !entry.good) {
+            invalid += 1;
+        }
+    }
+
+    QString summary = QString("Processed %1 proof(s), %2 error(s)").arg(QString::number(results.size()), QString::number(failed));
+    if (m_batch->mode() == ProofBatch::Verify) {
+        summary += QString(", %1 invalid").arg(invalid);
+    }
+    ui->label_status->setText(summary);
+
+    QString input = QFileInfo(ui->line_file->text()).completeBaseName();
+    QString defaultName = QString("%1_report_%2.csv").arg(input, QString::number(QDateTime::currentSecsSinceEpoch()));
+    QString fn = Utils::getSaveFileName(this, "Save report", defaultName, "CSV Files (*.csv)");
+    if (!fn.isEmpty()) {
+        QString error = m_batch->writeReport(fn);
+        if (!error.isEmpty()) {
+            Utils::showError(this, "Unable to save report", error);
+        } else {
+            Utils::showInfo(this, "Report saved", QString("Saved to: %1").arg(fn));
+        }
+    }
+
+    m_batch.reset();
+}
+
+void ProofBatchDialog::setRunning(bool running) {
+    ui->progressBar->setVisible(running || ui->progressBar->value() > 0);
+    ui->btn_start->setEnabled(!running);
+    ui->btn_browse->setEnabled(!running);
+    ui->combo_mode->setEnabled(!running);
+    ui->btn_cancel->setVisible(running);
+    ui->btn_cancel->setEnabled(running);
+    ui->buttonBox->setEnabled(!running);
+}
+
+ProofBatchDialog::~ProofBatchDialog() = default;
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_PROOFBATCHDIALOG_H
+#define FEATHER_PROOFBATCHDIALOG_H
+
+#include <QDialog>
+
+#include "components.h"
+#include "libwalletqt/Wallet.h"
+
+namespace Ui {
+    class ProofBatchDialog;
+}
+
+class ProofBatchDialog : public WindowModalDialog
+{
+Q_OBJECT
+
+public:
+    explicit ProofBatchDialog(QWidget *parent, Wallet *wallet);
+    ~ProofBatchDialog() override;
+
+private slots:
+    void onBrowse();
+    void onStart();
+    void onCancel();
+    void onProgress(int done, int total);
+    void onFinished(bool success);
+
+private:
+    void setRunning(bool running);
+
+    QScopedPointer<Ui::ProofBatchDialog> ui;
+    Wallet *m_wallet;
+    QScopedPointer<ProofBatch> m_batch;
+};
+
+#endif //FEATHER_PROOFBATCHDIALOG_H
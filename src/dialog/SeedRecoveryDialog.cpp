@@ -6,13 +6,38 @@
 
 #include <monero_seed/wordlist.hpp>
 #include "ColorScheme.h"
+#include "constants.h"
 #include "utils/Utils.h"
+#include "utils/SeedRecovery.h"
 #include "polyseed/polyseed.h"
 #include "utils/AsyncTask.h"
 #include "device/device_default.hpp"
 #include "cryptonote_basic/account.h"
 #include "cryptonote_basic/cryptonote_basic_impl.h"
 
+namespace {
+    // Beyond this the search takes hours even with checksum pruning
+    constexpr quint64 MAX_ENUMERATIONS = 1000000000000;
+
+    bool keyMatchesAddress(const crypto::secret_key &key, const crypto::public_key &spkey, uint32_t major, uint32_t minor) {
+        cryptonote::account_base base;
+        base.generate(key, true, false);
+
+        hw::device &hwdev = base.get_device();
+
+        for (uint32_t x = 0; x < major; x++) {
+            const std::vector<crypto::public_key> pkeys = hwdev.get_subaddress_spend_public_keys(base.get_keys(), x, 0, minor);
+            for (const auto &k : pkeys) {
+                if (k == spkey) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+}
+
 SeedRecoveryDialog::SeedRecoveryDialog(QWidget *parent)
         : WindowModalDialog(parent)
         , m_scheduler(this)
@@ -29,6 +54,8 @@ SeedRecoveryDialog::SeedRecoveryDialog(QWidget *parent)
     ui->buttonBox->button(QDialogButtonBox::Apply)->setText("Check");
 
     connect(this, &SeedRecoveryDialog::progressUpdated, this, &SeedRecoveryDialog::onProgressUpdated);
+    connect(ui->combo_seedType, &QComboBox::currentIndexChanged, this, &SeedRecoveryDialog::onSeedTypeChanged);
+    this->onSeedTypeChanged(ui->combo_seedType->currentIndex());
 
     disconnect(ui->buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
     connect(ui->buttonBox->button(QDialogButtonBox::Apply), &QPushButton::clicked, this, &SeedRecoveryDialog::checkSeed);
@@ -118,6 +145,16 @@ void SeedRecoveryDialog::onProgressUpdated(int value) {
     ui->progressBar->setValue(value);
 }
 
+void SeedRecoveryDialog::onSeedTypeChanged(int index) {
+    bool polyseed = (index == 0);
+
+    ui->word_15->setVisible(polyseed);
+    ui->word_16->setVisible(polyseed);
+    ui->label_14->setVisible(polyseed);
+    ui->label_16->setVisible(polyseed);
+    ui->spin_typos->setEnabled(!polyseed);
+}
+
 void SeedRecoveryDialog::checkSeed() {
     m_cancelled = false;
 
@@ -147,6 +184,11 @@ void SeedRecoveryDialog::checkSeed() {
         return a->objectName() < b->objectName();
     });
 
+    bool polyseed = (ui->combo_seedType->currentIndex() == 0);
+    if (!polyseed) {
+        lineEdits = lineEdits.mid(0, monero_seed::phrase_size);
+    }
+
     QList<QStringList> words;
     uint64_t combinations = 1;
 
@@ -204,11 +246,16 @@ void SeedRecoveryDialog::checkSeed() {
 
     qDebug() << "Number of possible combinations: " << combinations;
 
-    ui->progressBar->setMaximum(combinations / 1000);
-
     uint32_t major = ui->line_majorLookahead->text().toInt();
     uint32_t minor = ui->line_minorLookahead->text().toInt();
 
+    if (!polyseed) {
+        this->checkMoneroSeed(words, spkey, major, minor);
+        return;
+    }
+
+    ui->progressBar->setMaximum(combinations / 1000);
+
     // Single threaded for now
     const auto future = m_scheduler.run([this, words, spkey, major, minor]{
         QList<int> index(16, 0);
@@ -243,20 +290,10 @@ void SeedRecoveryDialog::checkSeed() {
                 continue;
             }
 
-            cryptonote::account_base base;
-            base.generate(key, true, false);
-
-            hw::device &hwdev = base.get_device();
-
-            for (int x = 0; x < major; x++) {
-                const std::vector<crypto::public_key> pkeys = hwdev.get_subaddress_spend_public_keys(base.get_keys(), x, 0, minor);
-                for (const auto &k : pkeys) {
-                    if (k == spkey) {
-                        emit addressMatchFound(seedString);
-                        emit searchFinished(false);
-                        return;
-                    }
-                }
+            if (keyMatchesAddress(key, spkey, major, minor)) {
+                emit addressMatchFound(seedString);
+                emit searchFinished(false);
+                return;
             }
         } while (findNext(words, index));
 
@@ -266,4 +303,54 @@ void SeedRecoveryDialog::checkSeed() {
     m_watcher.setFuture(future.second);
 }
 
+void SeedRecoveryDialog::checkMoneroSeed(const QList<QStringList> &words, const crypto::public_key &spkey, uint32_t major, uint32_t minor) {
+    QList<QList<int>> indices;
+    for (const auto &possibleWords : words) {
+        QList<int> position;
+        for (const auto &word : possibleWords) {
+            position.append(m_wordList.indexOf(word));
+        }
+        indices.append(position);
+    }
+
+    auto recovery = std::make_shared<SeedRecovery>(indices, ui->spin_typos->value(), QString::fromStdString(constants::coinName));
+
+    qDebug() << "Number of enumerations: " << recovery->enumerations();
+
+    if (recovery->enumerations() > MAX_ENUMERATIONS) {
+        Utils::showError(this, "Too many possible seeds", "Recovery infeasible");
+        this->onFinished(false);
+        return;
+    }
+
+    ui->progressBar->setMaximum(100);
+
+    const auto future = m_scheduler.run([this, recovery, spkey, major, minor]{
+        recovery->run(m_cancelled, [this](int percent) {
+            emit progressUpdated(percent);
+        }, [this, spkey, major, minor](const monero_seed::recovery_candidate &candidate) {
+            QString seedString = SeedRecovery::mnemonic(candidate.words);
+
+            // Handle case where we don't know an address
+            if (spkey == crypto::null_pkey) {
+                emit matchFound(seedString);
+                return false;
+            }
+
+            crypto::secret_key key;
+            memcpy(key.data, candidate.key.data(), sizeof(key.data));
+
+            if (keyMatchesAddress(key, spkey, major, minor)) {
+                emit addressMatchFound(seedString);
+                return true;
+            }
+            return false;
+        });
+
+        emit searchFinished(m_cancelled);
+    });
+
+    m_watcher.setFuture(future.second);
+}
+
 SeedRecoveryDialog::~SeedRecoveryDialog() = default;
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include "components.h"
 #include "utils/scheduler.h"
+#include "crypto/crypto.h"
 
 namespace Ui {
     class SeedRecoveryDialog;
@@ -32,9 +33,11 @@ private slots:
     void onMatchFound(const QString &match);
     void onAddressMatchFound(const QString &match);
     void onProgressUpdated(int value);
+    void onSeedTypeChanged(int index);
 
 private:
     void checkSeed();
+    void checkMoneroSeed(const QList<QStringList> &words, const crypto::public_key &spkey, uint32_t major, uint32_t minor);
     QStringList wordsWithRegex(const QRegularExpression &regex);
     bool isAlpha(const QString &word);
     bool findNext(const QList<QStringList> &words, QList<int> &index);
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "SyncOverviewDialog.h"
+#include "ui_SyncOverviewDialog.h"
+
+#include <QTreeWidgetItem>
+
+#include "libwalletqt/SyncScheduler.h"
+
+SyncOverviewDialog::SyncOverviewDialog(QWidget *parent)
+        : QDialog(parent)
+        , ui(new Ui::SyncOverviewDialog)
+{
+    ui->setupUi(this);
+
+    ui->tree_wallets->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    ui->tree_wallets->header()->setStretchLastSection(true);
+
+    connect(syncScheduler(), &SyncScheduler::walletsChanged, this, &SyncOverviewDialog::updateWallets);
+
+    this->updateWallets();
+}
+
+void SyncOverviewDialog::updateWallets() {
+    auto wallets = syncScheduler()->wallets();
+    std::sort(wallets.begin(), wallets.end(), [](const WalletSyncInfo &a, const WalletSyncInfo &b) {
+        return a.walletName < b.walletName;
+    });
+
+    // Reuse items, this is called for every scanned block
+    while (ui->tree_wallets->topLevelItemCount() > wallets.size()) {
+        delete ui->tree_wallets->takeTopLevelItem(ui->tree_wallets->topLevelItemCount() - 1);
+    }
+    while (ui->tree_wallets->topLevelItemCount() < wallets.size()) {
+        ui->tree_wallets->addTopLevelItem(new QTreeWidgetItem());
+    }
+
+    for (int i = 0; i < wallets.size(); i++) {
+        const WalletSyncInfo &info = wallets[i];
+        QTreeWidgetItem *item = ui->tree_wallets->topLevelItem(i);
+
+        quint64 remaining = (info.targetHeight > info.height + 1) ? info.targetHeight - info.height - 1 : 0;
+
+        QString status;
+        switch (info.state) {
+            case WalletSyncInfo::Refreshing:
+                status = remaining > 0 ? "Synchronizing" : "Refreshing";
+                break;
+            case WalletSyncInfo::Waiting:
+                status = "Waiting";
+                break;
+            default:
+                status = info.lastRefresh.isValid() ? "Idle" : "Not connected";
+        }
+
+        item->setText(0, info.walletName);
+        item->setText(1, status);
+        item->setText(2, info.height > 0 ? QString::number(info.height) : "");
+        item->setText(3, info.targetHeight > 0 ? QString::number(remaining) : "");
+        item->setText(4, info.blocksPerSecond > 0 ? QString::number(info.blocksPerSecond, 'f', 1) : "");
+        item->setText(5, info.daemonAddress);
+
+        for (int column : {2, 3, 4}) {
+            item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+}
+
+SyncOverviewDialog::~SyncOverviewDialog() = default;
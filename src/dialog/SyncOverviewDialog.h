@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_SYNCOVERVIEWDIALOG_H
+#define FEATHER_SYNCOVERVIEWDIALOG_H
+
+#include <QDialog>
+
+namespace Ui {
+    class SyncOverviewDialog;
+}
+
+class SyncOverviewDialog : public QDialog
+{
+Q_OBJECT
+
+public:
+    explicit SyncOverviewDialog(QWidget *parent = nullptr);
+    ~SyncOverviewDialog() override;
+
+private:
+    void updateWallets();
+
+    QScopedPointer<Ui::SyncOverviewDialog> ui;
+};
+
+#endif //FEATHER_SYNCOVERVIEWDIALOG_H
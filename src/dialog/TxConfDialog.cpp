@@ -71,6 +71,15 @@ TxConfDialog::TxConfDialog(Wallet *wallet, PendingTransaction *tx, const QString
         ui->label_address->setToolTip("Wallet change/primary address");
     }
 
+    const CoinSelection &selection = tx->coinSelection();
+    if (selection.isValid() && selection.saving() > 0) {
+        ui->label_note->setText(QString("Note: coin selection saved about %1 XMR in fees (%2 inputs instead of %3).")
+                                        .arg(WalletManager::displayAmount(selection.saving()),
+                                             QString::number(selection.keyImages.size()),
+                                             QString::number(selection.defaultInputs)));
+        ui->label_note->show();
+    }
+
     if (tx->fee() > WalletManager::amountFromDouble(0.01)) {
         ui->label_fee->setStyleSheet(ColorScheme::RED.asStylesheet(true));
         ui->label_fee->setToolTip("Unrealistic fee. You may be connected to a malicious node.");
@@ -4,41 +4,204 @@
 #include "TxImportDialog.h"
 #include "ui_TxImportDialog.h"
 
+#include <QFileDialog>
+#include <QHeaderView>
 #include <QMessageBox>
 
 #include "utils/NetworkManager.h"
 
+namespace {
+    // Restricted nodes return at most 100 transactions per get_transactions request
+    constexpr int BATCH_SIZE = 100;
+}
+
 TxImportDialog::TxImportDialog(QWidget *parent, Wallet *wallet)
         : WindowModalDialog(parent)
         , ui(new Ui::TxImportDialog)
         , m_wallet(wallet)
+        , m_scheduler(this)
 {
     ui->setupUi(this);
 
+    ui->tree_results->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    ui->tree_results->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    ui->tree_results->hide();
+
     connect(ui->btn_import, &QPushButton::clicked, this, &TxImportDialog::onImport);
+    connect(ui->btn_loadFile, &QPushButton::clicked, this, &TxImportDialog::onLoadFile);
+    connect(this, &TxImportDialog::batchLookedUp, this, &TxImportDialog::onBatchLookedUp);
+    connect(this, &TxImportDialog::lookupFinished, this, &TxImportDialog::scanFound);
+    connect(this, &TxImportDialog::batchScanned, this, &TxImportDialog::onBatchScanned);
+    connect(this, &TxImportDialog::scanFinished, this, &TxImportDialog::onScanFinished);
 
     this->adjustSize();
 }
 
+void TxImportDialog::onLoadFile() {
+    QString fn = QFileDialog::getOpenFileName(this, "Load transaction IDs", QDir::homePath(), "Text files (*.txt *.csv);;All files (*)");
+    if (fn.isEmpty()) {
+        return;
+    }
+
+    QFile file(fn);
+    if (!file.open(QIODevice::ReadOnly)) {
+        Utils::showError(this, "Failed to load file", file.errorString());
+        return;
+    }
+
+    ui->text_txids->appendPlainText(QString::fromUtf8(file.readAll()));
+}
+
+void TxImportDialog::setResult(const QString &txid, const QString &result) {
+    if (auto *item = m_items.value(txid)) {
+        item->setText(1, result);
+    }
+}
+
 void TxImportDialog::onImport() {
-    QString txid = ui->line_txid->text();
+    static const QRegularExpression separators("[\\s,;]+");
+    static const QRegularExpression txidRe("^[0-9a-f]{64}$");
+
+    QStringList tokens = ui->text_txids->toPlainText().split(separators, Qt::SkipEmptyParts);
+    if (tokens.isEmpty()) {
+        return;
+    }
+
+    ui->tree_results->clear();
+    ui->tree_results->show();
+    m_items.clear();
+    m_found.clear();
+    m_imported = 0;
+
+    QStringList toLookup;
+    for (const auto &token : tokens) {
+        QString txid = token.toLower();
+        if (m_items.contains(txid)) {
+            // Listed once more, the first entry carries the result
+            new QTreeWidgetItem(ui->tree_results, {txid, "Duplicate"});
+            continue;
+        }
+        m_items[txid] = new QTreeWidgetItem(ui->tree_results, {txid, ""});
+
+        if (!txidRe.match(txid).hasMatch()) {
+            this->setResult(txid, "Invalid transaction ID");
+            continue;
+        }
+
+        if (m_wallet->haveTransaction(txid)) {
+            this->setResult(txid, "Already in wallet (check other accounts)");
+            continue;
+        }
+
+        this->setResult(txid, "Looking up");
+        toLookup.append(txid);
+    }
+
+    if (toLookup.isEmpty()) {
+        ui->label_status->setText("Nothing to import");
+        return;
+    }
+
+    QList<QStringList> batches;
+    for (int i = 0; i < toLookup.size(); i += BATCH_SIZE) {
+        batches.append(toLookup.mid(i, BATCH_SIZE));
+    }
+
+    ui->btn_import->setEnabled(false);
+    ui->btn_loadFile->setEnabled(false);
+    ui->label_status->setText(QString("Looking up %1 transaction(s)").arg(toLookup.size()));
+
+    // Through the wallet's own daemon connection, which knows the node's login, TLS and proxy settings
+    m_scheduler.run([this, batches] {
+        for (const auto &batch : batches) {
+            if (m_cancelled) {
+                return;
+            }
+            QHash<QString, quint64> found;
+            QString error;
+            bool success = m_wallet->lookupTransactions(batch, found, error);
+            emit batchLookedUp(batch, found, success, error);
+        }
+        emit lookupFinished();
+    });
+}
 
-    if (m_wallet->haveTransaction(txid)) {
-        Utils::showWarning(this, "Transaction already exists in wallet", "If you can't find it in your history, "
-                                                                       "check if it belongs to a different account (Wallet -> Account)");
+void TxImportDialog::onBatchLookedUp(const QStringList &txids, const QHash<QString, quint64> &found, bool success, const QString &error) {
+    for (const auto &txid : txids) {
+        if (!success) {
+            this->setResult(txid, QString("Lookup failed: %1").arg(error));
+        }
+        else if (found.contains(txid)) {
+            m_found.append({found.value(txid), txid});
+            this->setResult(txid, "Queued");
+        }
+        else {
+            this->setResult(txid, "Not found on node");
+        }
+    }
+}
+
+void TxImportDialog::scanFound() {
+    if (m_found.isEmpty()) {
+        this->onScanFinished();
         return;
     }
 
-    if (m_wallet->importTransaction(txid)) {
-        if (!m_wallet->haveTransaction(txid)) {
-            Utils::showError(this, "Unable to import transaction", "This transaction does not belong to the wallet");
-            return;
+    // The wallet has to see outputs before the transactions that spend them
+    std::stable_sort(m_found.begin(), m_found.end(), [](const QPair<quint64, QString> &a, const QPair<quint64, QString> &b) {
+        return a.first < b.first;
+    });
+
+    QList<QStringList> batches;
+    for (int i = 0; i < m_found.size(); i += BATCH_SIZE) {
+        QStringList batch;
+        for (int j = i; j < std::min(i + BATCH_SIZE, static_cast<int>(m_found.size())); j++) {
+            batch.append(m_found[j].second);
+        }
+        batches.append(batch);
+    }
+
+    ui->label_status->setText(QString("Scanning %1 transaction(s)").arg(m_found.size()));
+
+    m_scheduler.run([this, batches] {
+        for (const auto &batch : batches) {
+            if (m_cancelled) {
+                break;
+            }
+            bool success = m_wallet->importTransactions(batch);
+            emit batchScanned(batch, success);
+        }
+        emit scanFinished();
+    });
+}
+
+void TxImportDialog::onBatchScanned(const QStringList &txids, bool success) {
+    for (const auto &txid : txids) {
+        if (!success) {
+            this->setResult(txid, "Failed to import transaction");
+        }
+        else if (m_wallet->haveTransaction(txid)) {
+            this->setResult(txid, "Imported");
+            m_imported += 1;
+        }
+        else {
+            this->setResult(txid, "Does not belong to this wallet");
         }
-        Utils::showInfo(this, "Transaction imported successfully", "");
-    } else {
-        Utils::showError(this, "Failed to import transaction", "");
     }
-    m_wallet->refreshModels();
 }
 
-TxImportDialog::~TxImportDialog() = default;
+void TxImportDialog::onScanFinished() {
+    if (m_imported > 0) {
+        m_wallet->updateBalance();
+        m_wallet->refreshModels();
+    }
+
+    ui->label_status->setText(QString("Imported %1 of %2 transaction(s)").arg(QString::number(m_imported), QString::number(m_items.size())));
+    ui->btn_import->setEnabled(true);
+    ui->btn_loadFile->setEnabled(true);
+}
+
+TxImportDialog::~TxImportDialog() {
+    m_cancelled = true;
+    m_scheduler.shutdownWaitForFinished();
+}
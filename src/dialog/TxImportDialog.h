@@ -5,9 +5,10 @@
 #define FEATHER_TXIMPORTDIALOG_H
 
 #include <QDialog>
+#include <QTreeWidgetItem>
 
 #include "components.h"
-#include "utils/daemonrpc.h"
+#include "utils/scheduler.h"
 #include "libwalletqt/Wallet.h"
 
 namespace Ui {
@@ -22,12 +23,32 @@ public:
     explicit TxImportDialog(QWidget *parent, Wallet *wallet);
     ~TxImportDialog() override;
 
+signals:
+    void batchLookedUp(const QStringList &txids, const QHash<QString, quint64> &found, bool success, const QString &error);
+    void lookupFinished();
+    void batchScanned(const QStringList &txids, bool success);
+    void scanFinished();
+
 private slots:
     void onImport();
+    void onLoadFile();
+    void onBatchLookedUp(const QStringList &txids, const QHash<QString, quint64> &found, bool success, const QString &error);
+    void onBatchScanned(const QStringList &txids, bool success);
+    void onScanFinished();
 
 private:
+    void scanFound();
+    void setResult(const QString &txid, const QString &result);
+
     QScopedPointer<Ui::TxImportDialog> ui;
     Wallet *m_wallet;
+
+    QHash<QString, QTreeWidgetItem*> m_items;
+    QList<QPair<quint64, QString>> m_found; // block height, txid
+    int m_imported = 0;
+
+    std::atomic<bool> m_cancelled = false;
+    FutureScheduler m_scheduler;
 };
 
 
@@ -29,7 +29,8 @@ TxInfoDialog::TxInfoDialog(Wallet *wallet, const TransactionRow &txInfo, QWidget
     ui->btn_viewOnBlockExplorer->setToolTip("View on block explorer");
     connect(ui->btn_viewOnBlockExplorer, &QPushButton::clicked, this, &TxInfoDialog::viewOnBlockExplorer);
 
-    m_txid = txInfo.hash;
+    m_txid = txInfo.hash();
+    m_rawTxid = txInfo.txid;
     ui->label_txid->setText(m_txid);
 
     connect(ui->btn_copyTxID, &QPushButton::clicked, this, &TxInfoDialog::copyTxID);
@@ -59,7 +60,7 @@ TxInfoDialog::TxInfoDialog(Wallet *wallet, const TransactionRow &txInfo, QWidget
 
     QTextCursor cursor = ui->outputs->textCursor();
 
-    auto transfers = txInfo.transfers;
+    auto transfers = m_wallet->history()->transfers(txInfo);
     if (!transfers.isEmpty()) {
         bool hasIntegrated = false;
 
@@ -153,7 +154,7 @@ void TxInfoDialog::updateData() {
     const auto& rows = m_wallet->history()->getRows();
     auto itr = std::find_if(rows.begin(), rows.end(),
             [&](const TransactionRow& ti) {
-        return ti.hash == m_txid;
+        return ti.txid == m_rawTxid;
     });
     if (itr == rows.end()) {
         return;
@@ -40,6 +40,7 @@ private:
     Wallet *m_wallet;
     TxProofDialog *m_txProofDialog;
     QString m_txid;
+    std::array<char, 32> m_rawTxid;
 };
 
 #endif //FEATHER_TXINFODIALOG_H
@@ -7,20 +7,33 @@
 #include <QTreeWidgetItem>
 
 #include "utils/Utils.h"
-#include "utils/ColorScheme.h"
+#include "libwalletqt/FeeEstimator.h"
 #include "libwalletqt/WalletManager.h"
+#include "model/TxPoolModel.h"
 
 TxPoolViewerDialog::TxPoolViewerDialog(QWidget *parent, Wallet *wallet)
         : QDialog(parent)
         , ui(new Ui::TxPoolViewerDialog)
         , m_wallet(wallet)
+        , m_model(new TxPoolModel(this))
 {
     ui->setupUi(this);
 
+    ui->tree_pool->setModel(m_model);
+    ui->tree_pool->header()->setSectionResizeMode(TxPoolModel::Weight, QHeaderView::ResizeToContents);
+    ui->tree_pool->header()->setSectionResizeMode(TxPoolModel::Fee, QHeaderView::ResizeToContents);
+    ui->tree_pool->sortByColumn(TxPoolModel::FeePerByte, Qt::DescendingOrder);
+
     connect(ui->btn_refresh, &QPushButton::clicked, this, &TxPoolViewerDialog::refresh);
     connect(m_wallet, &Wallet::poolStats, this, &TxPoolViewerDialog::onTxPoolBacklog);
 
-    ui->tree_pool->sortByColumn(2, Qt::DescendingOrder);
+    // Keep the view current while it's open, updates only touch rows that changed
+    connect(&m_refreshTimer, &QTimer::timeout, [this]{
+        if (this->isVisible() && ui->btn_refresh->isEnabled()) {
+            this->refresh();
+        }
+    });
+    m_refreshTimer.start(30 * 1000);
 
     this->refresh();
 }
@@ -30,17 +43,6 @@ void TxPoolViewerDialog::refresh() {
     m_wallet->getTxPoolStatsAsync();
 }
 
-class TxPoolSortItem : public QTreeWidgetItem {
-public:
-    using QTreeWidgetItem::QTreeWidgetItem;
-
-    bool operator<(const QTreeWidgetItem &other) const override {
-        int column = treeWidget()->sortColumn();
-
-        return this->data(column, Qt::UserRole).toUInt() < other.data(column, Qt::UserRole).toUInt();
-    }
-};
-
 void TxPoolViewerDialog::onTxPoolBacklog(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit) {
     ui->btn_refresh->setEnabled(true);
 
@@ -48,78 +50,20 @@ void TxPoolViewerDialog::onTxPoolBacklog(const QVector<TxBacklogEntry> &txPool,
         return;
     }
 
-    ui->tree_pool->clear();
-    ui->tree_feeTiers->clear();
-
-    m_feeTierStats.clear();
-    for (int i = 0; i < 4; i++) {
-        m_feeTierStats.push_back(FeeTierStats{});
-    }
+    m_model->updateBacklog(txPool, baseFees);
 
     ui->label_transactions->setText(QString::number(txPool.size()));
+    ui->label_totalWeight->setText(Utils::formatBytes(m_model->totalWeight()));
+    ui->label_totalFees->setText(QString("%1 XMR").arg(WalletManager::displayAmount(m_model->totalFees())));
 
-    uint64_t totalWeight = 0;
-    uint64_t totalFees = 0;
-    for (const auto &entry : txPool) {
-        totalWeight += entry.weight;
-        totalFees += entry.fee;
-
-        auto* item = new TxPoolSortItem();
-        item->setText(0, QString("%1 B").arg(QString::number(entry.weight)));
-        item->setData(0, Qt::UserRole, entry.weight);
-        item->setTextAlignment(0, Qt::AlignRight);
-
-        item->setText(1, QString("%1 XMR").arg(WalletManager::displayAmount(entry.fee)));
-        item->setData(1, Qt::UserRole, entry.fee);
-        item->setTextAlignment(1, Qt::AlignRight);
-
-        quint64 fee_per_byte = 0;
-        if (entry.weight > 0) {
-            fee_per_byte = entry.fee / entry.weight;
-        } else {
-            qWarning() << "Division by zero avoided: transaction weight is zero";
-        }
-        item->setText(2, QString::number(fee_per_byte));
-        item->setData(2, Qt::UserRole, fee_per_byte);
-        item->setTextAlignment(2, Qt::AlignRight);
+    FeeEstimate estimate = FeeEstimator::estimate(txPool, baseFees, blockWeightLimit);
+    ui->label_blockWeightLimit->setText(Utils::formatBytes(estimate.fullRewardZone));
 
-        if (fee_per_byte == baseFees[0]) {
-            item->setBackground(2, QBrush(ColorScheme::BLUE.asColor(true)));
-        }
-        if (fee_per_byte == baseFees[1]) {
-            item->setBackground(2, QBrush(ColorScheme::GREEN.asColor(true)));
-        }
-        if (fee_per_byte == baseFees[2]) {
-            item->setBackground(2, QBrush(ColorScheme::YELLOW.asColor(true)));
-        }
-        if (fee_per_byte == baseFees[3]) {
-            item->setBackground(2, QBrush(ColorScheme::RED.asColor(true)));
-        }
-
-        if (fee_per_byte >= baseFees[3]) {
-            m_feeTierStats[3].weightFromTip += entry.weight;
-        }
-        if (fee_per_byte >= baseFees[2]) {
-            m_feeTierStats[2].weightFromTip += entry.weight;
-        }
-        if (fee_per_byte >= baseFees[1]) {
-            m_feeTierStats[1].weightFromTip += entry.weight;
-        }
-        if (fee_per_byte >= baseFees[0]) {
-            m_feeTierStats[0].weightFromTip += entry.weight;
-        }
-
-        ui->tree_pool->addTopLevelItem(item);
+    if (!estimate.isValid()) {
+        return;
     }
 
-    ui->tree_pool->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
-    ui->tree_pool->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
-
-    ui->label_totalWeight->setText(Utils::formatBytes(totalWeight));
-    ui->label_totalFees->setText(QString("%1 XMR").arg(WalletManager::displayAmount(totalFees)));
-
-    quint64 fullRewardZone = blockWeightLimit >> 1;
-    ui->label_blockWeightLimit->setText(Utils::formatBytes(fullRewardZone));
+    ui->tree_feeTiers->clear();
 
     for (int i = 0; i < 4; i++) {
         QString tierName;
@@ -139,16 +83,18 @@ void TxPoolViewerDialog::onTxPoolBacklog(const QVector<TxBacklogEntry> &txPool,
                 break;
         }
 
+        const FeeTierEstimate &tier = estimate.tiers[i];
+
         auto* item = new QTreeWidgetItem();
         item->setText(0, tierName);
 
-        item->setText(1, QString::number(baseFees[i]));
+        item->setText(1, QString::number(tier.feePerByte));
         item->setTextAlignment(1, Qt::AlignRight);
 
-        item->setText(2, QString(" %1 blocks").arg(QString::number(m_feeTierStats[i].weightFromTip / fullRewardZone))); // approximation
+        item->setText(2, QString(" %1 blocks").arg(QString::number(tier.blocks))); // approximation
         item->setTextAlignment(2, Qt::AlignRight);
 
-        item->setText(3, QString("%1 kB").arg(QString::number(m_feeTierStats[i].weightFromTip / 1000)));
+        item->setText(3, QString("%1 kB").arg(QString::number(tier.weightAhead / 1000)));
         item->setTextAlignment(3, Qt::AlignRight);
 
         ui->tree_feeTiers->addTopLevelItem(item);
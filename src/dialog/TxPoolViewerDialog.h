@@ -5,6 +5,7 @@
 #define FEATHER_TXPOOLVIEWERDIALOG_H
 
 #include <QDialog>
+#include <QTimer>
 
 #include "components.h"
 #include "libwalletqt/Wallet.h"
@@ -13,11 +14,7 @@ namespace Ui {
     class TxPoolViewerDialog;
 }
 
-struct FeeTierStats {
-  quint64 transactions = 0;
-  quint64 totalWeight = 0;
-  quint64 weightFromTip = 0;
-};
+class TxPoolModel;
 
 class TxPoolViewerDialog : public QDialog
 {
@@ -31,9 +28,10 @@ private:
     void refresh();
     void onTxPoolBacklog(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit);
 
-    QVector<FeeTierStats> m_feeTierStats;
     QScopedPointer<Ui::TxPoolViewerDialog> ui;
     Wallet *m_wallet;
+    TxPoolModel *m_model;
+    QTimer m_refreshTimer;
 };
 
 
@@ -5,6 +5,18 @@
 
 #include <wallet/wallet2.h>
 
+namespace {
+    QString addressString(cryptonote::network_type nettype, const cryptonote::account_public_address &address, bool isSubaddress, const crypto::hash8 *paymentId)
+    {
+        std::string str;
+        if (paymentId)
+            str = cryptonote::get_account_integrated_address_as_str(nettype, address, *paymentId);
+        else
+            str = cryptonote::get_account_address_as_str(nettype, isSubaddress, address);
+        return QString::fromStdString(str);
+    }
+}
+
 AddressBook::AddressBook(tools::wallet2 *wallet2, QObject *parent)
     : QObject(parent)
     , m_wallet2(wallet2)
@@ -20,18 +32,35 @@ void AddressBook::refresh()
     m_rows.clear();
 
     for (const auto &row : m_wallet2->get_address_book()) {
-        std::string address;
-        if (row.m_has_payment_id)
-            address = cryptonote::get_account_integrated_address_as_str(m_wallet2->nettype(), row.m_address, row.m_payment_id);
-        else
-            address = get_account_address_as_str(m_wallet2->nettype(), row.m_is_subaddress, row.m_address);
-
-        m_rows.emplaceBack(QString::fromStdString(address), QString::fromStdString(row.m_description));
+        QString address = addressString(m_wallet2->nettype(), row.m_address, row.m_is_subaddress, row.m_has_payment_id ? &row.m_payment_id : nullptr);
+        m_rows.emplaceBack(address, QString::fromStdString(row.m_description));
     }
 
+    this->rebuildIndex();
+
     emit refreshFinished();
 }
 
+void AddressBook::indexRow(qsizetype index)
+{
+    const ContactRow &row = m_rows[index];
+    // Keep the first row if an address was added twice, that is the one a linear scan would find
+    if (!m_addressIndex.contains(row.address)) {
+        m_addressIndex.insert(row.address, index);
+    }
+    m_descriptionIndex.insert(row.label.toCaseFolded(), index);
+}
+
+void AddressBook::rebuildIndex()
+{
+    m_addressIndex.clear();
+    m_descriptionIndex.clear();
+    m_addressIndex.reserve(m_rows.size());
+    for (qsizetype i = 0; i < m_rows.size(); ++i) {
+        this->indexRow(i);
+    }
+}
+
 qsizetype AddressBook::count() const
 {
     return m_rows.length();
@@ -50,6 +79,33 @@ const QList<ContactRow>& AddressBook::getRows()
     return m_rows;
 }
 
+qsizetype AddressBook::indexOfAddress(const QString &address) const
+{
+    return m_addressIndex.value(address, -1);
+}
+
+qsizetype AddressBook::indexOfDescription(const QString &description) const
+{
+    qsizetype first = -1;
+    auto range = m_descriptionIndex.equal_range(description.toCaseFolded());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (m_rows[it.value()].label == description && (first < 0 || it.value() < first)) {
+            first = it.value();
+        }
+    }
+    return first;
+}
+
+QList<qsizetype> AddressBook::findByDescriptionPrefix(const QString &prefix) const
+{
+    QList<qsizetype> result;
+    QString key = prefix.toCaseFolded();
+    for (auto it = m_descriptionIndex.lowerBound(key); it != m_descriptionIndex.end() && it.key().startsWith(key); ++it) {
+        result.append(it.value());
+    }
+    return result;
+}
+
 bool AddressBook::addRow(const QString &address, const QString &description)
 {
     m_errorString = "";
@@ -61,37 +117,66 @@ bool AddressBook::addRow(const QString &address, const QString &description)
         return false;
     }
 
-    bool r = m_wallet2->add_address_book_row(info.address, info.has_payment_id ? &info.payment_id : nullptr, description.toStdString(), info.is_subaddress);
-    if (r)
-        refresh();
-    else
+    const crypto::hash8 *paymentId = info.has_payment_id ? &info.payment_id : nullptr;
+    bool r = m_wallet2->add_address_book_row(info.address, paymentId, description.toStdString(), info.is_subaddress);
+    if (!r) {
         m_errorCode = General_Error;
-    return r;
+        return false;
+    }
+
+    // wallet2 appends the new contact, mirror that instead of reloading the whole book
+    qsizetype index = m_rows.size();
+    emit beginAddRow(index);
+    m_rows.emplaceBack(addressString(m_wallet2->nettype(), info.address, info.is_subaddress, paymentId), description);
+    this->indexRow(index);
+    emit endAddRow();
+
+    return true;
 }
 
 bool AddressBook::setDescription(qsizetype index, const QString &description) {
     m_errorString = "";
 
-    const auto ab = m_wallet2->get_address_book();
-    if (index >= ab.size()){
+    if (index < 0 || index >= m_rows.size()) {
         return false;
     }
 
-    tools::wallet2::address_book_row entry = ab[index];
-    entry.m_description = description.toStdString();
-    bool r = m_wallet2->set_address_book_row(index, entry.m_address, entry.m_has_payment_id ? &entry.m_payment_id : nullptr, entry.m_description, entry.m_is_subaddress);
-    if (r)
-        refresh();
-    else
+    // Parse the address we already have rather than copying the address book out of wallet2
+    cryptonote::address_parse_info info;
+    if (!cryptonote::get_account_address_from_str(info, m_wallet2->nettype(), m_rows[index].address.toStdString())) {
         m_errorCode = General_Error;
-    return r;
+        return false;
+    }
+
+    bool r = m_wallet2->set_address_book_row(index, info.address, info.has_payment_id ? &info.payment_id : nullptr, description.toStdString(), info.is_subaddress);
+    if (!r) {
+        m_errorCode = General_Error;
+        return false;
+    }
+
+    ContactRow &row = m_rows[index];
+    m_descriptionIndex.remove(row.label.toCaseFolded(), index);
+    row.label = description;
+    m_descriptionIndex.insert(row.label.toCaseFolded(), index);
+    emit rowUpdated(index);
+
+    return true;
 }
 
 bool AddressBook::deleteRow(qsizetype index)
 {
+    if (index < 0 || index >= m_rows.size()) {
+        return false;
+    }
+
     bool r = m_wallet2->delete_address_book_row(index);
-    if (r)
-        refresh();
+    if (r) {
+        emit beginRemoveRow(index);
+        m_rows.removeAt(index);
+        // Rows after the deleted one shift up, so their indices change
+        this->rebuildIndex();
+        emit endRemoveRow();
+    }
     return r;
 }
 
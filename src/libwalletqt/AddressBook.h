@@ -5,7 +5,9 @@
 #define FEATHER_ADDRESSBOOK_H
 
 #include <QObject>
+#include <QHash>
 #include <QList>
+#include <QMultiMap>
 
 #include "rows/ContactRow.h"
 
@@ -41,20 +43,39 @@ public:
     bool setDescription(qsizetype index, const QString &description);
     bool deleteRow(qsizetype index);
 
+    //! Row of the contact with this address, or -1
+    qsizetype indexOfAddress(const QString &address) const;
+    //! Row of the first contact with this description, or -1
+    qsizetype indexOfDescription(const QString &description) const;
+    //! Rows whose description starts with prefix (case-insensitive), ordered by description
+    QList<qsizetype> findByDescriptionPrefix(const QString &prefix) const;
+
     QString errorString() const;
     ErrorCode errorCode() const;
 
 signals:
     void refreshStarted() const;
     void refreshFinished() const;
+    void rowUpdated(qsizetype index) const;
+    void beginAddRow(qsizetype index) const;
+    void endAddRow() const;
+    void beginRemoveRow(qsizetype index) const;
+    void endRemoveRow() const;
 
 private:
     explicit AddressBook(tools::wallet2 *wallet2, QObject *parent);
     friend class Wallet;
 
+    void indexRow(qsizetype index);
+    void rebuildIndex();
+
     tools::wallet2 *m_wallet2;
     QList<ContactRow> m_rows;
 
+    // Lookups by address and description, kept in sync with m_rows on every edit
+    QHash<QString, qsizetype> m_addressIndex;
+    QMultiMap<QString, qsizetype> m_descriptionIndex;
+
     QString m_errorString;
     ErrorCode m_errorCode;
 };
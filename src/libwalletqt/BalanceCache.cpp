@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "BalanceCache.h"
+
+#include <algorithm>
+
+#include "wallet/wallet2.h"
+
+namespace {
+    QByteArray hashBytes(const crypto::hash &hash) {
+        return QByteArray(reinterpret_cast<const char*>(hash.data), sizeof(hash.data));
+    }
+}
+
+BalanceCache::BalanceCache(tools::wallet2 *wallet2, QObject *parent)
+        : QObject(parent)
+        , m_wallet2(wallet2)
+{
+}
+
+BalanceAmounts BalanceCache::account(quint32 accountIndex) {
+    QMutexLocker locker(&m_mutex);
+    this->update();
+    return m_accounts.value(accountIndex);
+}
+
+BalanceAmounts BalanceCache::subaddress(quint32 accountIndex, quint32 addressIndex) {
+    QMutexLocker locker(&m_mutex);
+    this->update();
+    return m_subaddresses.value(subaddressKey(accountIndex, addressIndex));
+}
+
+BalanceAmounts BalanceCache::total() {
+    QMutexLocker locker(&m_mutex);
+    this->update();
+    return m_total;
+}
+
+QList<BalanceAmounts> BalanceCache::accounts() {
+    QMutexLocker locker(&m_mutex);
+    this->update();
+    return m_accounts;
+}
+
+void BalanceCache::invalidate() {
+    QMutexLocker locker(&m_mutex);
+    m_stale = true;
+}
+
+void BalanceCache::onMoneySpent() {
+    QMutexLocker locker(&m_mutex);
+    m_recheckSpent = true;
+}
+
+quint64 BalanceCache::subaddressKey(quint32 accountIndex, quint32 addressIndex) {
+    return (quint64(accountIndex) << 32) | addressIndex;
+}
+
+void BalanceCache::scan(size_t from) {
+    const size_t numTransfers = m_wallet2->get_num_transfer_details();
+    for (size_t i = from; i < numTransfers; i++) {
+        const auto &td = m_wallet2->get_transfer_details(i);
+        if (!m_wallet2->is_spent(td, false) && !td.m_frozen) {
+            m_unspent.push_back(i);
+        }
+    }
+
+    m_transfersScanned = numTransfers;
+    m_lastTransferTxid = numTransfers > 0 ? hashBytes(m_wallet2->get_transfer_details(numTransfers - 1).m_txid) : QByteArray();
+}
+
+void BalanceCache::update() {
+    const quint64 height = m_wallet2->get_blockchain_current_height();
+    const size_t numTransfers = m_wallet2->get_num_transfer_details();
+    const qsizetype numAccounts = m_wallet2->get_num_subaddress_accounts();
+
+    // Unconfirmed outgoing transactions add their change to the balance of the account, and give their inputs back
+    // when they fail. Both lists only hold transactions that are not mined yet, so they stay short.
+    std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> upayments_out;
+    m_wallet2->get_unconfirmed_payments_out(upayments_out);
+    std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>> upayments;
+    m_wallet2->get_unconfirmed_payments(upayments);
+
+    QByteArray unconfirmedOutKey;
+    for (const auto &p : upayments_out) {
+        unconfirmedOutKey += hashBytes(p.first);
+        unconfirmedOutKey += char(p.second.m_state);
+    }
+    QByteArray poolKey;
+    for (const auto &p : upayments) {
+        poolKey += hashBytes(p.second.m_pd.m_tx_hash);
+    }
+
+    // Transfers are only ever appended, unless the wallet detached blocks after a reorg. Detaching also marks outputs
+    // spent in the detached blocks as unspent again, even if no transfer was removed, so a lower height means a full pass.
+    bool reorg = height < m_height
+              || numTransfers < m_transfersScanned
+              || (m_transfersScanned > 0 && hashBytes(m_wallet2->get_transfer_details(m_transfersScanned - 1).m_txid) != m_lastTransferTxid);
+
+    if (m_stale || reorg || unconfirmedOutKey != m_unconfirmedOutKey) {
+        m_unspent.clear();
+        this->scan(0);
+    }
+    else if (numTransfers != m_transfersScanned || m_recheckSpent || height != m_height || poolKey != m_poolKey
+             || numAccounts != m_accounts.size()) {
+        if (m_recheckSpent) {
+            m_unspent.erase(std::remove_if(m_unspent.begin(), m_unspent.end(), [this](size_t i) {
+                return m_wallet2->is_spent(m_wallet2->get_transfer_details(i), false);
+            }), m_unspent.end());
+        }
+        this->scan(m_transfersScanned);
+    }
+    else {
+        return;
+    }
+
+    m_stale = false;
+    m_recheckSpent = false;
+    m_height = height;
+    m_unconfirmedOutKey = unconfirmedOutKey;
+    m_poolKey = poolKey;
+
+    m_accounts = QList<BalanceAmounts>(numAccounts);
+    m_subaddresses.clear();
+    m_total = {};
+
+    auto add = [this](const cryptonote::subaddress_index &index, const BalanceAmounts &amounts) {
+        if (index.major >= m_accounts.size()) {
+            return;
+        }
+        m_accounts[index.major] += amounts;
+        m_subaddresses[subaddressKey(index.major, index.minor)] += amounts;
+        m_total += amounts;
+    };
+
+    for (size_t i : m_unspent) {
+        const auto &td = m_wallet2->get_transfer_details(i);
+
+        BalanceAmounts amounts;
+        amounts.balance = td.amount();
+        if (m_wallet2->is_transfer_unlocked(td)) {
+            amounts.unlocked = td.amount();
+        }
+        add(td.m_subaddr_index, amounts);
+    }
+
+    for (const auto &p : upayments_out) {
+        const auto &utx = p.second;
+        if (utx.m_state == tools::wallet2::unconfirmed_transfer_details::failed) {
+            continue;
+        }
+
+        // All change goes to the primary address of the account
+        BalanceAmounts amounts;
+        amounts.balance = utx.m_change;
+        add({utx.m_subaddr_account, 0}, amounts);
+    }
+
+    for (const auto &p : upayments) {
+        const auto &pd = p.second.m_pd;
+
+        BalanceAmounts amounts;
+        amounts.pending = pd.m_amount;
+        add(pd.m_subaddr_index, amounts);
+    }
+}
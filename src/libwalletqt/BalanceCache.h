@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_BALANCECACHE_H
+#define FEATHER_BALANCECACHE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+#include <vector>
+
+namespace tools {
+    class wallet2;
+}
+
+struct BalanceAmounts {
+    quint64 balance = 0;  // Same as wallet2::balance(index, false)
+    quint64 unlocked = 0; // Same as wallet2::unlocked_balance(index, false)
+    quint64 pending = 0;  // Incoming transactions that are still in the pool, not part of the balance
+
+    BalanceAmounts& operator+=(const BalanceAmounts &other) {
+        balance += other.balance;
+        unlocked += other.unlocked;
+        pending += other.pending;
+        return *this;
+    }
+};
+
+// Balances of every account and subaddress, computed in a single pass over the wallet's transfers. wallet2 walks all
+// transfers for every account it is asked about, which does not scale to wallets with hundreds of accounts.
+//
+// Results are cached until the wallet height or its set of transfers changes. New transfers (moneyReceived) are
+// folded into the cache and spends (moneySpent) only recheck the outputs that were still unspent. A drop in height
+// (reorg) triggers a full pass. Anything else that can mark outputs unspent again, like importing key images or
+// transactions, or rescanning spent outputs, must call invalidate().
+class BalanceCache : public QObject
+{
+Q_OBJECT
+
+public:
+    BalanceAmounts account(quint32 accountIndex);
+    BalanceAmounts subaddress(quint32 accountIndex, quint32 addressIndex);
+    BalanceAmounts total();
+
+    //! Indexed by account
+    QList<BalanceAmounts> accounts();
+
+    //! Frozen or thawed outputs, imported key images or outputs, rescanned spends: the next read does a full pass
+    void invalidate();
+
+    void onMoneySpent();
+
+private:
+    explicit BalanceCache(tools::wallet2 *wallet2, QObject *parent = nullptr);
+    friend class Wallet;
+
+    void update();
+    void scan(size_t from);
+
+    static quint64 subaddressKey(quint32 accountIndex, quint32 addressIndex);
+
+    tools::wallet2 *m_wallet2;
+
+    QMutex m_mutex;
+
+    bool m_stale = true;
+    bool m_recheckSpent = false;
+
+    // State the cache was computed for
+    quint64 m_height = 0;
+    size_t m_transfersScanned = 0;
+    QByteArray m_lastTransferTxid;
+    QByteArray m_unconfirmedOutKey;
+    QByteArray m_poolKey;
+
+    // Transfers that are neither spent nor frozen
+    std::vector<size_t> m_unspent;
+
+    QList<BalanceAmounts> m_accounts;
+    QHash<quint64, BalanceAmounts> m_subaddresses;
+    BalanceAmounts m_total;
+};
+
+#endif //FEATHER_BALANCECACHE_H
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "BlockHashCache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+
+#include "utils/config.h"
+
+#include "wallet/wallet2.h"
+
+namespace {
+    constexpr qint64 HASH_SIZE = sizeof(crypto::hash);
+
+    // Only blocks this deep are cached, shallower reorgs never reach the file
+    constexpr quint64 CONFIRMATIONS = 60;
+
+    // Number of overlapping hashes compared against a contributing wallet
+    constexpr quint64 VERIFY_DEPTH = 1000;
+}
+
+BlockHashCache* BlockHashCache::instance() {
+    static BlockHashCache cache;
+    return &cache;
+}
+
+QString BlockHashCache::path(int nettype, const QString &daemonAddress) const {
+    QDir dir(Config::defaultConfigDir().path() + "/blockchain");
+    QByteArray daemon = QCryptographicHash::hash(daemonAddress.toLower().toUtf8(), QCryptographicHash::Sha256).toHex().left(16);
+    return dir.filePath(QString("hashes_%1_%2.bin").arg(QString::number(nettype), QString::fromLatin1(daemon)));
+}
+
+quint64 BlockHashCache::height(int nettype, const QString &daemonAddress) {
+    QMutexLocker locker(&m_mutex);
+    QFileInfo info(this->path(nettype, daemonAddress));
+    if (!info.exists()) {
+        return 0;
+    }
+    return info.size() / HASH_SIZE;
+}
+
+bool BlockHashCache::readHashes(const QString &path, quint64 start, quint64 count, QByteArray &out) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    if (!file.seek(start * HASH_SIZE)) {
+        return false;
+    }
+
+    out = file.read(count * HASH_SIZE);
+    return out.size() == static_cast<qsizetype>(count * HASH_SIZE);
+}
+
+quint64 BlockHashCache::seed(tools::wallet2 *wallet2, const QString &daemonAddress) {
+    // Only a wallet that holds nothing but the genesis block can take foreign hashes without
+    // skipping blocks it still has to scan.
+    if (wallet2->get_blockchain_current_height() > 1) {
+        return 0;
+    }
+
+    quint64 restoreHeight = wallet2->get_refresh_from_block_height();
+    if (restoreHeight <= 1) {
+        return 0;
+    }
+
+    int nettype = static_cast<int>(wallet2->nettype());
+    auto ownChain = wallet2->export_blockchain();
+    if (std::get<2>(ownChain).size() != 1) {
+        return 0;
+    }
+    const crypto::hash &genesis = std::get<2>(ownChain)[0];
+
+    QMutexLocker locker(&m_mutex);
+
+    QString path = this->path(nettype, daemonAddress);
+    QFileInfo info(path);
+    quint64 cacheHeight = info.exists() ? info.size() / HASH_SIZE : 0;
+    quint64 count = std::min(cacheHeight, restoreHeight);
+    if (count <= 1) {
+        return 0;
+    }
+
+    QByteArray data;
+    if (!this->readHashes(path, 0, count, data)) {
+        qWarning() << "BlockHashCache: unable to read cache";
+        return 0;
+    }
+
+    if (memcmp(data.constData(), genesis.data, HASH_SIZE) != 0) {
+        qWarning() << "BlockHashCache: genesis mismatch, ignoring cache";
+        return 0;
+    }
+
+    std::tuple<size_t, crypto::hash, std::vector<crypto::hash>> blockchain;
+    std::get<0>(blockchain) = 0;
+    std::get<1>(blockchain) = genesis;
+    std::get<2>(blockchain).resize(count);
+    memcpy(std::get<2>(blockchain).data(), data.constData(), count * HASH_SIZE);
+
+    wallet2->import_blockchain(blockchain);
+
+    qInfo() << "BlockHashCache: imported" << count << "block hashes";
+    return count;
+}
+
+void BlockHashCache::contribute(int nettype, const QString &daemonAddress, const std::tuple<size_t, crypto::hash, std::vector<crypto::hash>> &blockchain) {
+    const quint64 offset = std::get<0>(blockchain);
+    const auto &hashes = std::get<2>(blockchain);
+    const quint64 tip = offset + hashes.size();
+
+    if (tip <= CONFIRMATIONS) {
+        return;
+    }
+    const quint64 confirmedTip = tip - CONFIRMATIONS;
+
+    QMutexLocker locker(&m_mutex);
+
+    QString path = this->path(nettype, daemonAddress);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qWarning() << "BlockHashCache: unable to open" << path;
+        return;
+    }
+
+    quint64 cacheHeight = file.size() / HASH_SIZE;
+    if (static_cast<quint64>(file.size()) != cacheHeight * HASH_SIZE) {
+        // Torn write, drop the partial hash
+        file.resize(cacheHeight * HASH_SIZE);
+    }
+
+    // The genesis hash identifies the chain, a wallet trimmed past it still carries it separately
+    const crypto::hash &genesis = (offset == 0) ? hashes.front() : std::get<1>(blockchain);
+    if (cacheHeight > 0) {
+        QByteArray cachedGenesis = file.read(HASH_SIZE);
+        if (memcmp(cachedGenesis.constData(), genesis.data, HASH_SIZE) != 0) {
+            return;
+        }
+    }
+    else if (offset != 0) {
+        // Can't start the cache without the hashes from genesis
+        return;
+    }
+
+    // Verify the tail of the overlap, anything the wallet disagrees with was reorganized away
+    quint64 overlapEnd = std::min(cacheHeight, confirmedTip);
+    quint64 overlapStart = std::max(offset, overlapEnd > VERIFY_DEPTH ? overlapEnd - VERIFY_DEPTH : 0);
+    if (overlapEnd > overlapStart) {
+        file.seek(overlapStart * HASH_SIZE);
+        QByteArray cached = file.read((overlapEnd - overlapStart) * HASH_SIZE);
+        quint64 verified = cached.size() / HASH_SIZE;
+
+        for (quint64 i = 0; i < verified; i++) {
+            const crypto::hash &ours = hashes[overlapStart + i - offset];
+            if (memcmp(cached.constData() + i * HASH_SIZE, ours.data, HASH_SIZE) != 0) {
+                quint64 forkHeight = overlapStart + i;
+                qInfo() << "BlockHashCache: reorg detected at height" << forkHeight << ", truncating cache";
+                file.resize(forkHeight * HASH_SIZE);
+                cacheHeight = forkHeight;
+                break;
+            }
+        }
+    }
+
+    if (confirmedTip <= cacheHeight || offset > cacheHeight) {
+        return;
+    }
+
+    file.seek(cacheHeight * HASH_SIZE);
+    const auto *begin = reinterpret_cast<const char*>(hashes.data() + (cacheHeight - offset));
+    qint64 size = (confirmedTip - cacheHeight) * HASH_SIZE;
+    if (file.write(begin, size) != size) {
+        qWarning() << "BlockHashCache: failed to extend cache";
+        file.resize(cacheHeight * HASH_SIZE);
+    }
+}
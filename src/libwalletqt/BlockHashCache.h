@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_BLOCKHASHCACHE_H
+#define FEATHER_BLOCKHASHCACHE_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+
+#include <tuple>
+#include <vector>
+
+#include "crypto/hash.h"
+
+namespace tools {
+    class wallet2;
+}
+
+// Process-wide on-disk cache of the block hash chain, shared by all open wallets.
+//
+// Wallets restored from a height first download every block hash from genesis up to that height before
+// they start scanning. The cache lets a restore (or any other fresh wallet in the process) import the
+// hashes another wallet already fetched, so only the blocks past the restore height are requested from
+// the daemon. Hashes are stored per network type and daemon as a flat array indexed by height in the config
+// dir: the chain is only checked against the genesis block, so hashes served by one node are never handed to
+// a wallet that syncs from another.
+class BlockHashCache
+{
+public:
+    static BlockHashCache* instance();
+
+    //! Imports cached hashes into a wallet that has not fetched anything yet, up to its restore height.
+    //! Must be called before the first refresh. Returns the number of imported hashes.
+    quint64 seed(tools::wallet2 *wallet2, const QString &daemonAddress);
+
+    //! Adds the confirmed part of a wallet's hash chain, truncating the cache where it disagrees (reorg)
+    void contribute(int nettype, const QString &daemonAddress, const std::tuple<size_t, crypto::hash, std::vector<crypto::hash>> &blockchain);
+
+    quint64 height(int nettype, const QString &daemonAddress);
+
+private:
+    BlockHashCache() = default;
+
+    QString path(int nettype, const QString &daemonAddress) const;
+    bool readHashes(const QString &path, quint64 start, quint64 count, QByteArray &out);
+
+    QMutex m_mutex;
+};
+
+#endif //FEATHER_BLOCKHASHCACHE_H
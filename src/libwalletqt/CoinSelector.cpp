@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "CoinSelector.h"
+
+#include <QHash>
+
+#include <algorithm>
+#include <tuple>
+
+namespace {
+    // Upper bound on the branches visited, the best set found until then is used
+    constexpr int MAX_TRIES = 100000;
+
+    struct Cost {
+        int subaddresses = 0;
+        quint64 excess = 0;
+        quint64 heights = 0; // Lower is older
+
+        bool operator<(const Cost &other) const {
+            return std::tie(subaddresses, excess, heights) < std::tie(other.subaddresses, other.excess, other.heights);
+        }
+    };
+
+    // Branch and bound over the sets of exactly k coins that cover the needed amount
+    struct Search {
+        const QVector<CoinCandidate> &coins; // Largest first
+        const QVector<int> &subaddress;      // Compact subaddress id of every coin
+        const QVector<quint64> &prefix;      // prefix[i] is the sum of the first i coins
+        const int k;
+        const quint64 needed;
+
+        QVector<int> picks;
+        QVector<int> used; // Picked coins per subaddress
+        int numUsed = 0;
+        quint64 heights = 0;
+
+        QVector<int> best;
+        Cost bestCost;
+        int tries = 0;
+        bool done = false;
+
+        Search(const QVector<CoinCandidate> &coins, const QVector<int> &subaddress, const QVector<quint64> &prefix, int k, quint64 needed)
+            : coins(coins), subaddress(subaddress), prefix(prefix), k(k), needed(needed) {}
+
+        quint64 sum(int from, int count) const {
+            return prefix[from + count] - prefix[from];
+        }
+
+        void visit(int pos, quint64 total) {
+            const int n = coins.size();
+            const int remaining = k - picks.size();
+
+            if (remaining == 0) {
+                Cost cost{numUsed, total - needed, heights};
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    best = picks;
+                    done = (cost.subaddresses == 1 && cost.excess == 0);
+                }
+                return;
+            }
+
+            for (int i = pos; i + remaining <= n && !done; i++) {
+                if (++tries > MAX_TRIES) {
+                    done = true;
+                    return;
+                }
+
+                // The largest coins left don't cover the amount, the ones after them won't either
+                if (total + sum(i, remaining) < needed) {
+                    return;
+                }
+
+                // Lower bound for the cost of any set that picks this coin: the smallest coins fill the other slots
+                const int sub = subaddress[i];
+                const int withSub = numUsed + (used[sub] == 0 ? 1 : 0);
+                const quint64 lowest = total + coins[i].amount + sum(n - remaining + 1, remaining - 1);
+                Cost bound{withSub, lowest > needed ? lowest - needed : 0, 0};
+                if (!(bound < bestCost)) {
+                    continue;
+                }
+
+                picks.append(i);
+                used[sub] += 1;
+                numUsed = withSub;
+                heights += coins[i].blockHeight;
+
+                this->visit(i + 1, total + coins[i].amount);
+
+                heights -= coins[i].blockHeight;
+                used[sub] -= 1;
+                numUsed -= (used[sub] == 0 ? 1 : 0);
+                picks.removeLast();
+            }
+        }
+    };
+
+    // Inputs wallet2 would use without coin control. pick_preferred_rct_inputs looks for a single output, then for a
+    // pair of outputs that covers the amount. If there is none, outputs are added until the amount is covered, which
+    // is modelled here as oldest first. Candidates are in transfer order.
+    int defaultInputs(const QVector<CoinCandidate> &candidates, const std::function<quint64(int)> &needed) {
+        quint64 largest = 0;
+        quint64 second = 0;
+        for (const auto &coin : candidates) {
+            if (coin.amount >= needed(1)) {
+                return 1;
+            }
+            if (coin.amount > largest) {
+                second = largest;
+                largest = coin.amount;
+            } else if (coin.amount > second) {
+                second = coin.amount;
+            }
+        }
+
+        if (candidates.size() >= 2 && largest + second >= needed(2)) {
+            return 2;
+        }
+
+        quint64 total = 0;
+        for (int i = 0; i < candidates.size(); i++) {
+            total += candidates[i].amount;
+            if (total >= needed(i + 1)) {
+                return i + 1;
+            }
+        }
+
+        return 0;
+    }
+}
+
+CoinSelection CoinSelector::select(const QVector<CoinCandidate> &candidates, quint64 target, bool subtractFee, const FeeFunction &fee) {
+    CoinSelection selection;
+    if (candidates.isEmpty() || target == 0) {
+        return selection;
+    }
+
+    auto needed = [target, subtractFee, &fee](int numInputs) {
+        return subtractFee ? target : target + fee(numInputs);
+    };
+
+    QVector<CoinCandidate> coins = candidates;
+    std::stable_sort(coins.begin(), coins.end(), [](const CoinCandidate &a, const CoinCandidate &b) {
+        return a.amount != b.amount ? a.amount > b.amount : a.blockHeight < b.blockHeight;
+    });
+
+    const int n = coins.size();
+    QVector<quint64> prefix(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        prefix[i + 1] = prefix[i] + coins[i].amount;
+    }
+
+    // No set of k coins sums to more than the k largest ones, so this is the smallest number of inputs that works
+    int k = 0;
+    for (int i = 1; i <= std::min(n, maxInputs); i++) {
+        if (prefix[i] >= needed(i)) {
+            k = i;
+            break;
+        }
+    }
+    if (k == 0) {
+        return selection;
+    }
+
+    QHash<quint32, int> subaddressIds;
+    QVector<int> subaddress(n);
+    for (int i = 0; i < n; i++) {
+        subaddress[i] = subaddressIds.value(coins[i].subaddrIndex, subaddressIds.size());
+        subaddressIds.insert(coins[i].subaddrIndex, subaddress[i]);
+    }
+
+    Search search(coins, subaddress, prefix, k, needed(k));
+    search.used = QVector<int>(subaddressIds.size(), 0);
+
+    // The k largest coins always work, start from there
+    QVector<int> greedyUsed(subaddressIds.size(), 0);
+    for (int i = 0; i < k; i++) {
+        search.best.append(i);
+        if (greedyUsed[subaddress[i]]++ == 0) {
+            search.bestCost.subaddresses += 1;
+        }
+        search.bestCost.heights += coins[i].blockHeight;
+    }
+    search.bestCost.excess = prefix[k] - search.needed;
+
+    search.visit(0, 0);
+
+    for (int i : search.best) {
+        selection.keyImages.append(coins[i].keyImage);
+        selection.inputAmount += coins[i].amount;
+    }
+    selection.fee = fee(k);
+
+    selection.defaultInputs = defaultInputs(candidates, needed);
+    if (selection.defaultInputs > 0) {
+        selection.defaultFee = fee(selection.defaultInputs);
+    }
+
+    return selection;
+}
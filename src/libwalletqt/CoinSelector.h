@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_COINSELECTOR_H
+#define FEATHER_COINSELECTOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+
+struct CoinCandidate {
+    quint64 amount = 0;
+    quint32 subaddrIndex = 0;
+    quint64 blockHeight = 0;
+    QString keyImage;
+};
+
+struct CoinSelection {
+    QStringList keyImages;
+    quint64 inputAmount = 0;
+    quint64 fee = 0;         // Estimated fee with the selected inputs
+    int defaultInputs = 0;   // Inputs wallet2's default picker is expected to use
+    quint64 defaultFee = 0;  // Estimated fee with those inputs
+
+    bool isValid() const {
+        return !keyImages.isEmpty();
+    }
+
+    quint64 saving() const {
+        return defaultFee > fee ? defaultFee - fee : 0;
+    }
+};
+
+// Picks the inputs for a transaction that minimize its fee. Every input adds a ring signature to the transaction, which
+// makes up most of its weight, so the search looks for the smallest number of inputs that covers the amount and fee.
+// Among those it prefers inputs from fewer subaddresses (spending from several subaddresses links them), then the
+// set with the least change, then older outputs.
+//
+// Candidates must already be spendable: unspent, unlocked, not frozen and from the current account.
+namespace CoinSelector
+{
+    using FeeFunction = std::function<quint64(int numInputs)>;
+
+    //! target excludes the fee, unless subtractFee is set. Returns an invalid selection if no set of at most
+    //! maxInputs candidates covers the target, wallet2 should pick the inputs then.
+    CoinSelection select(const QVector<CoinCandidate> &candidates, quint64 target, bool subtractFee, const FeeFunction &fee);
+
+    constexpr int maxInputs = 64;
+}
+
+#endif //FEATHER_COINSELECTOR_H
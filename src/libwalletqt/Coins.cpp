@@ -2,27 +2,117 @@
 // SPDX-FileCopyrightText: The Monero Project
 
 #include "Coins.h"
+
+#include <QElapsedTimer>
+
+#include "BalanceCache.h"
 #include "rows/CoinsInfo.h"
 #include "Wallet.h"
+#include "utils/ScopeGuard.h"
 #include <wallet/wallet2.h>
 
 Coins::Coins(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent)
         : QObject(parent)
         , m_wallet(wallet)
         , m_wallet2(wallet2)
+        , m_scheduler(this)
 {
-
+    connect(this, &Coins::rowsLoaded, this, &Coins::onRowsLoaded, Qt::QueuedConnection);
 }
 
 void Coins::refresh()
 {
     qDebug() << Q_FUNC_INFO;
 
+    // Not shown yet, load() fills the rows the first time
+    if (!m_loaded) {
+        if (m_loading) {
+            m_refreshPending = true;
+        }
+        return;
+    }
+
+    QList<CoinsInfo> rows = this->fetchRows();
+
     emit refreshStarted();
+    m_rows = std::move(rows);
+    emit refreshFinished();
+}
+
+void Coins::load()
+{
+    if (m_loaded || m_loading) {
+        return;
+    }
+
+    m_loading = true;
+    m_refreshPending = false;
+    m_scheduler.run([this] {
+        QElapsedTimer timer;
+        timer.start();
+
+        // The refresh thread writes the containers fetchRows() reads, hold the wallet while copying them
+        QList<CoinsInfo> rows;
+        {
+            while (!m_wallet->m_asyncMutex.tryLock(100)) {
+                if (m_scheduler.stopping()) {
+                    return;
+                }
+            }
+            const auto unlock = sg::make_scope_guard([this]() noexcept {
+                m_wallet->m_asyncMutex.unlock();
+            });
+            rows = this->fetchRows();
+        }
+
+        emit rowsLoaded(rows, timer.elapsed());
+    });
+}
+
+void Coins::ensureLoaded()
+{
+    if (m_loaded) {
+        return;
+    }
+
+    m_loaded = true;
+    this->refresh();
+}
+
+bool Coins::isLoaded() const
+{
+    return m_loaded;
+}
+
+void Coins::onRowsLoaded(const QList<CoinsInfo> &rows, qint64 elapsed)
+{
+    m_loading = false;
+
+    // ensureLoaded() got there first
+    if (m_loaded) {
+        return;
+    }
+
+    qInfo() << "Coins loaded:" << rows.size() << "rows in" << elapsed << "ms";
+
+    emit refreshStarted();
+    m_rows = rows;
+    m_loaded = true;
+    emit refreshFinished();
+
+    // The wallet changed while the rows were fetched
+    if (m_refreshPending) {
+        m_refreshPending = false;
+        this->refresh();
+    }
+}
+
+QList<CoinsInfo> Coins::fetchRows() const
+{
+    QList<CoinsInfo> rows;
 
     boost::shared_lock<boost::shared_mutex> transfers_lock(m_wallet2->m_transfers_mutex);
 
-    m_rows.clear();
     for (size_t i = 0; i < m_wallet2->get_num_transfer_details(); ++i)
     {
         const tools::wallet2::transfer_details &td = m_wallet2->get_transfer_details(i);
@@ -56,10 +146,10 @@ void Coins::refresh()
         ci.description = m_wallet->getCacheAttribute(QString("coin.description:%1").arg(ci.pubKey));
         ci.change = m_wallet2->is_change(td);
 
-        m_rows.push_back(ci);
+        rows.push_back(ci);
     }
 
-    emit refreshFinished();
+    return rows;
 }
 
 quint64 Coins::count() const
@@ -108,6 +198,7 @@ void Coins::freeze(QStringList &publicKeys)
         }
     }
 
+    m_wallet->balanceCache()->invalidate();
     refresh();
 }
 
@@ -132,6 +223,7 @@ void Coins::thaw(QStringList &publicKeys)
         }
     }
 
+    m_wallet->balanceCache()->invalidate();
     refresh();
 }
 
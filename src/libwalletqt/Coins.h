@@ -8,6 +8,9 @@
 #include <QList>
 #include <QReadWriteLock>
 
+#include "rows/CoinsInfo.h"
+#include "utils/scheduler.h"
+
 namespace Monero {
     struct TransactionHistory;
 }
@@ -16,14 +19,19 @@ namespace tools {
     class wallet2;
 }
 
-class CoinsInfo;
 class Wallet;
 class Coins : public QObject
 {
 Q_OBJECT
 
 public:
+    //! Does nothing until the rows are loaded
     void refresh();
+    //! Fills the rows on a worker thread, called when the coins are first shown
+    void load();
+    //! Fills the rows right away, for callers that need them before the coins were shown
+    void ensureLoaded();
+    bool isLoaded() const;
     quint64 count() const;
 
     const CoinsInfo& getRow(qsizetype i);
@@ -39,13 +47,25 @@ signals:
     void refreshFinished() const;
     void descriptionChanged() const;
 
+    // Emitted from the worker thread, delivered to onRowsLoaded on the GUI thread
+    void rowsLoaded(const QList<CoinsInfo> &rows, qint64 elapsed) const;
+
 private:
     explicit Coins(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent = nullptr);
     friend class Wallet;
 
+    QList<CoinsInfo> fetchRows() const;
+    void onRowsLoaded(const QList<CoinsInfo> &rows, qint64 elapsed);
+
     Wallet *m_wallet;
     tools::wallet2 *m_wallet2;
     QList<CoinsInfo> m_rows;
+
+    bool m_loaded = false;
+    bool m_loading = false;
+    bool m_refreshPending = false;
+
+    FutureScheduler m_scheduler;
 };
 
 #endif //FEATHER_COINS_H
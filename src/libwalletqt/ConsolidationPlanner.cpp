@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "ConsolidationPlanner.h"
+
+#include <QMap>
+
+#include <algorithm>
+
+ConsolidationPlan ConsolidationPlanner::plan(const QVector<CoinCandidate> &candidates, int maxInputs, bool mergeSubaddresses, const CoinSelector::FeeFunction &fee) {
+    ConsolidationPlan plan;
+    plan.outputs = candidates.size();
+
+    maxInputs = std::clamp(maxInputs, 2, CoinSelector::maxInputs);
+
+    // What one more input adds to the fee of a transaction
+    const quint64 inputCost = fee(2) - fee(1);
+
+    QMap<quint32, QVector<CoinCandidate>> groups;
+    for (const auto &coin : candidates) {
+        if (coin.amount <= inputCost) {
+            plan.skippedDust += 1;
+            plan.dustAmount += coin.amount;
+            continue;
+        }
+        groups[mergeSubaddresses ? 0 : coin.subaddrIndex].append(coin);
+    }
+
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+        QVector<CoinCandidate> &coins = it.value();
+
+        // Outputs received around the same time end up in the same transaction
+        std::stable_sort(coins.begin(), coins.end(), [](const CoinCandidate &a, const CoinCandidate &b) {
+            return a.blockHeight < b.blockHeight;
+        });
+
+        const int n = coins.size();
+        const int numBatches = (n + maxInputs - 1) / maxInputs;
+
+        int offset = 0;
+        for (int i = 0; i < numBatches; i++) {
+            const int size = n / numBatches + (i < n % numBatches ? 1 : 0);
+
+            // Sweeping a single output does not consolidate anything
+            if (size < 2) {
+                plan.skippedSingles += size;
+                for (int j = offset; j < offset + size; j++) {
+                    plan.singlesAmount += coins[j].amount;
+                }
+            }
+            else {
+                ConsolidationBatch batch;
+                batch.subaddrIndex = it.key();
+                for (int j = offset; j < offset + size; j++) {
+                    batch.keyImages.append(coins[j].keyImage);
+                    batch.amount += coins[j].amount;
+                }
+                batch.estimatedFee = fee(size);
+                plan.batches.append(batch);
+            }
+
+            offset += size;
+        }
+    }
+
+    return plan;
+}
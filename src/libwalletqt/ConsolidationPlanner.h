@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_CONSOLIDATIONPLANNER_H
+#define FEATHER_CONSOLIDATIONPLANNER_H
+
+#include <QStringList>
+#include <QVector>
+
+#include "CoinSelector.h"
+
+struct ConsolidationBatch {
+    QStringList keyImages;
+    quint32 subaddrIndex = 0; // Destination of the sweep, the primary address if the batch mixes subaddresses
+    quint64 amount = 0;
+    quint64 estimatedFee = 0;
+};
+
+struct ConsolidationPlan {
+    QVector<ConsolidationBatch> batches;
+    int outputs = 0;          // Spendable outputs considered
+    int skippedDust = 0;      // Outputs worth less than the fee to spend them
+    quint64 dustAmount = 0;
+    int skippedSingles = 0;   // The only output of their subaddress, there is nothing to combine them with
+    quint64 singlesAmount = 0;
+
+    quint64 totalFee() const {
+        quint64 fee = 0;
+        for (const auto &batch : batches) {
+            fee += batch.estimatedFee;
+        }
+        return fee;
+    }
+
+    int inputs() const {
+        int inputs = 0;
+        for (const auto &batch : batches) {
+            inputs += batch.keyImages.size();
+        }
+        return inputs;
+    }
+};
+
+// Groups spendable outputs into sweep transactions of at most maxInputs inputs each. Every batch turns its inputs into
+// a single output, so the number of outputs left is the same for any grouping; the planner uses as few transactions
+// as possible and spreads the inputs evenly over them.
+//
+// Outputs are only combined with outputs of the same subaddress unless mergeSubaddresses is set, spending from
+// several subaddresses in one transaction links them. Outputs that would cost more in fees than they are worth, and
+// outputs that have no other output to be combined with, are left alone and counted in the plan.
+namespace ConsolidationPlanner
+{
+    //! fee takes the number of inputs of a transaction with two outputs (destination and change)
+    ConsolidationPlan plan(const QVector<CoinCandidate> &candidates, int maxInputs, bool mergeSubaddresses, const CoinSelector::FeeFunction &fee);
+}
+
+#endif //FEATHER_CONSOLIDATIONPLANNER_H
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "FeeEstimator.h"
+
+#include <QMap>
+
+#include "Wallet.h"
+
+namespace {
+    constexpr int REFRESH_INTERVAL_MS = 2 * 60 * 1000;
+    constexpr qint64 MAX_ESTIMATE_AGE_SECS = 5 * 60;
+}
+
+FeeEstimator::FeeEstimator(Wallet *wallet, QObject *parent)
+        : QObject(parent)
+        , m_wallet(wallet)
+        , m_refreshTimer(new QTimer(this))
+{
+    connect(m_refreshTimer, &QTimer::timeout, this, &FeeEstimator::refresh);
+    connect(m_wallet, &Wallet::walletRefreshed, this, &FeeEstimator::refresh);
+    m_refreshTimer->start(REFRESH_INTERVAL_MS);
+}
+
+FeeEstimate FeeEstimator::estimate(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit) {
+    FeeEstimate result;
+    result.timestamp = QDateTime::currentDateTimeUtc();
+
+    if (baseFees.size() != 4 || blockWeightLimit == 0) {
+        return result;
+    }
+
+    result.fullRewardZone = blockWeightLimit >> 1;
+
+    QMap<quint64, FeeHistogramBin> bins;
+    for (const auto &entry : txPool) {
+        if (entry.weight == 0) {
+            continue;
+        }
+
+        quint64 feePerByte = entry.fee / entry.weight;
+        FeeHistogramBin &bin = bins[feePerByte];
+        bin.feePerByte = feePerByte;
+        bin.transactions += 1;
+        bin.weight += entry.weight;
+
+        result.poolWeight += entry.weight;
+    }
+
+    result.histogram.reserve(bins.size());
+    for (auto it = bins.crbegin(); it != bins.crend(); ++it) {
+        result.histogram.append(*it);
+    }
+
+    // Walk the histogram from the highest fee down, accumulating the weight that will be mined before each tier
+    for (quint64 baseFee : baseFees) {
+        FeeTierEstimate tier;
+        tier.feePerByte = baseFee;
+        for (const auto &bin : result.histogram) {
+            if (bin.feePerByte < baseFee) {
+                break;
+            }
+            tier.weightAhead += bin.weight;
+        }
+        tier.blocks = tier.weightAhead / result.fullRewardZone;
+        result.tiers.append(tier);
+    }
+
+    return result;
+}
+
+void FeeEstimator::update(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit) {
+    FeeEstimate estimate = FeeEstimator::estimate(txPool, baseFees, blockWeightLimit);
+    if (!estimate.isValid()) {
+        return;
+    }
+
+    bool changed = false;
+    {
+        QWriteLocker locker(&m_lock);
+        changed = !m_estimate.isValid() || m_estimate.fullRewardZone != estimate.fullRewardZone;
+        for (int i = 0; !changed && i < estimate.tiers.size(); i++) {
+            changed = m_estimate.tiers[i].feePerByte != estimate.tiers[i].feePerByte
+                   || m_estimate.tiers[i].blocks != estimate.tiers[i].blocks;
+        }
+        m_estimate = std::move(estimate);
+    }
+
+    // Only notify consumers when a projection they display or act on has moved
+    if (changed) {
+        emit estimateUpdated();
+    }
+}
+
+FeeEstimate FeeEstimator::current() const {
+    QReadLocker locker(&m_lock);
+    return m_estimate;
+}
+
+bool FeeEstimator::isFresh() const {
+    QReadLocker locker(&m_lock);
+    return m_estimate.isValid() && m_estimate.timestamp.secsTo(QDateTime::currentDateTimeUtc()) < MAX_ESTIMATE_AGE_SECS;
+}
+
+int FeeEstimator::automaticFeeLevel() const {
+    if (!this->isFresh()) {
+        return 0;
+    }
+
+    QReadLocker locker(&m_lock);
+    return automaticFeeLevel(m_estimate);
+}
+
+int FeeEstimator::automaticFeeLevel(const FeeEstimate &estimate) {
+    // Same range as wallet2::adjust_priority: only pick Low if it will not be stuck behind a backlog,
+    // raising the fee further is left to the user.
+    if (estimate.tiers[0].blocks == 0) {
+        return 1;
+    }
+    return 2;
+}
+
+qint64 FeeEstimator::blocksForFeeLevel(int feeLevel) const {
+    QReadLocker locker(&m_lock);
+    if (!m_estimate.isValid() || feeLevel < 0 || feeLevel > 4) {
+        return -1;
+    }
+
+    if (feeLevel == 0) {
+        feeLevel = automaticFeeLevel(m_estimate);
+    }
+
+    return m_estimate.tiers[feeLevel - 1].blocks;
+}
+
+void FeeEstimator::refresh() {
+    if (!m_wallet->isSynchronized()) {
+        return;
+    }
+
+    m_wallet->getTxPoolStatsAsync();
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_FEEESTIMATOR_H
+#define FEATHER_FEEESTIMATOR_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QReadWriteLock>
+#include <QTimer>
+#include <QVector>
+
+#include "rows/TxBacklogEntry.h"
+
+class Wallet;
+
+struct FeeHistogramBin {
+    quint64 feePerByte = 0;
+    quint64 transactions = 0;
+    quint64 weight = 0;
+};
+
+struct FeeTierEstimate {
+    quint64 feePerByte = 0;  // Base fee of this tier
+    quint64 weightAhead = 0; // Pool weight paying at least this tier's fee
+    quint64 blocks = 0;      // Full blocks that have to be mined before a tx at this tier fits
+};
+
+struct FeeEstimate {
+    QVector<FeeHistogramBin> histogram; // Sorted by fee-per-byte, highest first
+    QVector<FeeTierEstimate> tiers;     // Low, Normal, High, Highest
+    quint64 poolWeight = 0;
+    quint64 fullRewardZone = 0;
+    QDateTime timestamp;
+
+    bool isValid() const {
+        return tiers.size() == 4 && fullRewardZone > 0;
+    }
+};
+
+class FeeEstimator : public QObject
+{
+Q_OBJECT
+
+public:
+    //! Bins the pool backlog by fee-per-byte and projects the wait for each fee tier
+    static FeeEstimate estimate(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit);
+
+    //! Thread safe, may be called from the wallet's worker threads
+    void update(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit);
+
+    FeeEstimate current() const;
+    bool isFresh() const;
+
+    //! Lowest of the automatic fee levels (Low, Normal) that is expected to confirm in the next block.
+    //! Returns 0 if no fresh estimate is available.
+    int automaticFeeLevel() const;
+
+    //! Projected wait in blocks for a fee level as used by createTransaction (0 = automatic).
+    //! Returns -1 if no estimate is available.
+    qint64 blocksForFeeLevel(int feeLevel) const;
+
+    void refresh();
+
+signals:
+    void estimateUpdated();
+
+private:
+    explicit FeeEstimator(Wallet *wallet, QObject *parent = nullptr);
+    friend class Wallet;
+
+    static int automaticFeeLevel(const FeeEstimate &estimate);
+
+    Wallet *m_wallet;
+    QTimer *m_refreshTimer;
+
+    mutable QReadWriteLock m_lock;
+    FeeEstimate m_estimate;
+};
+
+#endif //FEATHER_FEEESTIMATOR_H
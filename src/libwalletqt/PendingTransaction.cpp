@@ -94,6 +94,10 @@ const PendingTransactionInfo& PendingTransaction::transaction(int index) const {
     return m_pending_tx_info[index];
 }
 
+const CoinSelection& PendingTransaction::coinSelection() const {
+    return m_coinSelection;
+}
+
 void PendingTransaction::refresh()
 {
     m_pending_tx_info.clear();
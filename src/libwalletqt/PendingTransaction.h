@@ -7,6 +7,7 @@
 #include <QObject>
 #include <QList>
 
+#include "CoinSelector.h"
 #include "rows/PendingTransactionInfo.h"
 
 namespace Monero {
@@ -44,6 +45,9 @@ public:
 
     const PendingTransactionInfo& transaction(int index) const;
 
+    //! Inputs picked by the fee-minimizing coin selection, invalid if wallet2 or the user picked them
+    const CoinSelection& coinSelection() const;
+
 private:
     explicit PendingTransaction(Monero::PendingTransaction * pt, QObject *parent = nullptr);
 
@@ -51,6 +55,7 @@ private:
     friend class Wallet;
     Monero::PendingTransaction * m_pimpl;
     mutable QList<PendingTransactionInfo> m_pending_tx_info;
+    CoinSelection m_coinSelection;
 };
 
 #endif // FEATHER_PENDINGTRANSACTION_H
@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "ProofBatch.h"
+
+#include <QFile>
+#include <QSet>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+
+#include "utils/Utils.h"
+#include "wallet/wallet2.h"
+
+namespace {
+    // Restricted nodes refuse get_transactions requests for more than 100 transactions
+    constexpr int TX_FETCH_BATCH_SIZE = 100;
+
+    struct CachedTx {
+        cryptonote::transaction tx;
+        bool inPool = false;
+        quint64 blockHeight = 0;
+    };
+}
+
+ProofBatch::ProofBatch(tools::wallet2 *wallet2, Mode mode, const QList<ProofBatchEntry> &entries, QObject *parent)
+        : QObject(parent)
+        , m_wallet2(wallet2)
+        , m_mode(mode)
+        , m_entries(entries)
+        , m_scheduler(this)
+{
+}
+
+ProofBatch::~ProofBatch() {
+    m_cancelled = true;
+    m_scheduler.shutdownWaitForFinished();
+}
+
+QString ProofBatch::readCSV(const QString &fileName, Mode mode, QList<ProofBatchEntry> &entries) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QString("Could not open file: %1").arg(fileName);
+    }
+
+    QTextStream in(&file);
+
+    QList<QStringList> fields;
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+        if (!line.trimmed().isEmpty()) {
+            fields.append(Utils::parseCSVLine(line));
+        }
+    }
+
+    if (fields.empty()) {
+        return "CSV file appears to be empty";
+    }
+
+    QStringList header = fields[0];
+    qint64 txidField = header.indexOf("txid");
+    qint64 addressField = header.indexOf("address");
+    qint64 messageField = header.indexOf("message");
+    qint64 signatureField = header.indexOf("signature");
+
+    if (txidField < 0) {
+        return "'txid' field not found in CSV header";
+    }
+    if (addressField < 0) {
+        return "'address' field not found in CSV header";
+    }
+    if (mode == Verify && signatureField < 0) {
+        return "'signature' field not found in CSV header";
+    }
+
+    entries.clear();
+    for (qsizetype i = 1; i < fields.size(); i++) {
+        const QStringList &row = fields[i];
+
+        ProofBatchEntry entry;
+        entry.txid = row.value(txidField).toLower();
+        entry.address = row.value(addressField);
+        entry.message = row.value(messageField);
+        if (mode == Verify) {
+            entry.signature = row.value(signatureField);
+        }
+        entries.append(entry);
+    }
+
+    if (entries.empty()) {
+        return "CSV file contains no proofs";
+    }
+
+    return {};
+}
+
+void ProofBatch::start() {
+    m_cancelled = false;
+    m_scheduler.run([this] {
+        this->run();
+    });
+}
+
+void ProofBatch::cancel() {
+    m_cancelled = true;
+}
+
+ProofBatch::Mode ProofBatch::mode() const {
+    return m_mode;
+}
+
+int ProofBatch::count() const {
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+QList<ProofBatchEntry> ProofBatch::results() const {
+    QMutexLocker locker(&m_mutex);
+    return m_entries;
+}
+
+QString ProofBatch::writeReport(const QString &fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        return QString("Could not open file: %1").arg(fileName);
+    }
+
+    QTextStream out(&file);
+    out << "txid,address,message,signature,status,received,in_pool,confirmations,error\n";
+
+    for (const auto &entry : this->results()) {
+        QString status;
+        if (!entry.success) {
+            status = "error";
+        } else if (m_mode == Generate) {
+            status = "ok";
+        } else {
+            status = entry.good ? "valid" : "invalid";
+        }
+
+        // Amounts and confirmations only exist for verified tx proofs
+        bool txProofResult = (m_mode == Verify && entry.success && !entry.address.isEmpty());
+
+        QStringList row = {
+            entry.txid,
+            entry.address,
+            entry.message,
+            entry.signature,
+            status,
+            txProofResult ? QString::number(entry.received) : QString(),
+            txProofResult ? QString(entry.inPool ? "true" : "false") : QString(),
+            txProofResult ? QString::number(entry.confirmations) : QString(),
+            entry.error
+        };
+        for (auto &field : row) {
+            field = Utils::csvField(field);
+        }
+        out << row.join(",") << "\n";
+    }
+
+    return {};
+}
+
+void ProofBatch::run() {
+    QList<ProofBatchEntry> entries = this->results();
+    const int total = entries.size();
+
+    // Fetch every transaction referenced by a tx proof up front, wallet2 would otherwise fetch it again for each proof
+    QStringList txids;
+    QSet<QString> seen;
+    for (const auto &entry : entries) {
+        if (!entry.address.isEmpty() && !seen.contains(entry.txid)) {
+            seen.insert(entry.txid);
+            txids.append(entry.txid);
+        }
+    }
+
+    std::unordered_map<std::string, CachedTx> txCache;
+    for (qsizetype i = 0; i < txids.size() && !m_cancelled; i += TX_FETCH_BATCH_SIZE) {
+        cryptonote::COMMAND_RPC_GET_TRANSACTIONS::request req;
+        cryptonote::COMMAND_RPC_GET_TRANSACTIONS::response res;
+        for (const auto &txid : txids.mid(i, TX_FETCH_BATCH_SIZE)) {
+            req.txs_hashes.push_back(txid.toStdString());
+        }
+        req.decode_as_json = false;
+        req.prune = false;
+
+        try {
+            if (!m_wallet2->invoke_http_json("/gettransactions", req, res) || res.status != CORE_RPC_STATUS_OK) {
+                continue;
+            }
+        }
+        catch (const std::exception &e) {
+            qWarning() << "Failed to fetch transactions for proofs:" << e.what();
+            continue;
+        }
+
+        for (const auto &txEntry : res.txs) {
+            cryptonote::blobdata blob;
+            if (!epee::string_tools::parse_hexstr_to_binbuff(txEntry.as_hex, blob)) {
+                continue;
+            }
+
+            CachedTx cached;
+            crypto::hash hash;
+            if (!cryptonote::parse_and_validate_tx_from_blob(blob, cached.tx, hash)) {
+                continue;
+            }
+
+            // Only trust the daemon for transactions we asked for
+            if (epee::string_tools::pod_to_hex(hash) != txEntry.tx_hash) {
+                continue;
+            }
+
+            cached.inPool = txEntry.in_pool;
+            cached.blockHeight = txEntry.block_height;
+            txCache.emplace(txEntry.tx_hash, std::move(cached));
+        }
+    }
+
+    std::string heightError;
+    const quint64 daemonHeight = m_wallet2->get_daemon_blockchain_height(heightError);
+
+    std::atomic<int> done = 0;
+    auto process = [&](ProofBatchEntry &entry) {
+        if (m_cancelled) {
+            return;
+        }
+
+        try {
+            crypto::hash txid;
+            if (!epee::string_tools::hex_to_pod(entry.txid.toStdString(), txid)) {
+                throw std::runtime_error("Invalid txid");
+            }
+
+            if (entry.address.isEmpty()) {
+                // Spend proofs need the ring members of every input, wallet2 fetches those itself
+                if (m_mode == Generate) {
+                    entry.signature = QString::fromStdString(m_wallet2->get_spend_proof(txid, entry.message.toStdString()));
+                } else {
+                    entry.good = m_wallet2->check_spend_proof(txid, entry.message.toStdString(), entry.signature.toStdString());
+                }
+                entry.success = true;
+            }
+            else {
+                cryptonote::address_parse_info info;
+                if (!cryptonote::get_account_address_from_str(info, m_wallet2->nettype(), entry.address.toStdString())) {
+                    throw std::runtime_error("Invalid address");
+                }
+
+                auto it = txCache.find(entry.txid.toStdString());
+                if (it == txCache.end()) {
+                    throw std::runtime_error("Transaction not found");
+                }
+                const CachedTx &cached = it->second;
+
+                if (m_mode == Generate) {
+                    // Same choice between an OutProof and an InProof as wallet2::get_tx_proof
+                    crypto::secret_key txKey = crypto::null_skey;
+                    std::vector<crypto::secret_key> additionalTxKeys;
+                    bool isOut = !m_wallet2->get_subaddress_index(info.address);
+                    if (isOut && !m_wallet2->get_tx_key(txid, txKey, additionalTxKeys)) {
+                        throw std::runtime_error("Tx secret key wasn't found in the wallet file.");
+                    }
+                    entry.signature = QString::fromStdString(m_wallet2->get_tx_proof(cached.tx, txKey, additionalTxKeys, info.address, info.is_subaddress, entry.message.toStdString()));
+                }
+                else {
+                    uint64_t received = 0;
+                    entry.good = m_wallet2->check_tx_proof(cached.tx, info.address, info.is_subaddress, entry.message.toStdString(), entry.signature.toStdString(), received);
+                    entry.received = received;
+                    entry.inPool = cached.inPool;
+                    entry.confirmations = (!cached.inPool && heightError.empty() && daemonHeight > cached.blockHeight) ? daemonHeight - cached.blockHeight : 0;
+                }
+                entry.success = true;
+            }
+        }
+        catch (const std::exception &e) {
+            entry.error = QString::fromStdString(e.what());
+        }
+
+        emit progress(++done, total);
+    };
+
+    // Hardware devices handle one request at a time
+    if (m_wallet2->get_device_type() == hw::device::SOFTWARE) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(QThread::idealThreadCount());
+        QtConcurrent::blockingMap(&pool, entries, process);
+    }
+    else {
+        for (auto &entry : entries) {
+            process(entry);
+        }
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_entries = entries;
+    }
+
+    emit finished(!m_cancelled);
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_PROOFBATCH_H
+#define FEATHER_PROOFBATCH_H
+
+#include <QObject>
+#include <QList>
+#include <QMutex>
+
+#include <atomic>
+
+#include "utils/scheduler.h"
+
+namespace tools {
+    class wallet2;
+}
+
+struct ProofBatchEntry {
+    QString txid;
+    QString address; // empty for spend proofs
+    QString message;
+    QString signature; // proof to verify, or the generated proof
+
+    bool success = false; // generation or verification ran to completion
+    bool good = false;
+    quint64 received = 0;
+    bool inPool = false;
+    quint64 confirmations = 0;
+    QString error;
+};
+
+// Generates or verifies a list of OutProofs/InProofs and SpendProofs across a thread pool. Transactions are fetched
+// from the daemon once per txid and shared by all tx proofs for that transaction.
+class ProofBatch : public QObject
+{
+Q_OBJECT
+
+public:
+    enum Mode {
+        Generate = 0,
+        Verify
+    };
+
+    ~ProofBatch() override;
+
+    //! Reads entries from a CSV file with a header naming txid, address, message and, to verify, signature columns.
+    //! Returns an error string, empty on success.
+    static QString readCSV(const QString &fileName, Mode mode, QList<ProofBatchEntry> &entries);
+
+    void start();
+    void cancel();
+
+    Mode mode() const;
+    int count() const;
+
+    //! Valid after finished()
+    QList<ProofBatchEntry> results() const;
+    QString writeReport(const QString &fileName) const;
+
+signals:
+    void progress(int done, int total);
+    void finished(bool success);
+
+private:
+    explicit ProofBatch(tools::wallet2 *wallet2, Mode mode, const QList<ProofBatchEntry> &entries, QObject *parent = nullptr);
+    friend class Wallet;
+
+    void run();
+
+    tools::wallet2 *m_wallet2;
+    Mode m_mode;
+
+    mutable QMutex m_mutex;
+    QList<ProofBatchEntry> m_entries;
+
+    std::atomic<bool> m_cancelled = false;
+    FutureScheduler m_scheduler;
+};
+
+#endif //FEATHER_PROOFBATCH_H
@@ -3,23 +3,51 @@
 
 #include "Subaddress.h"
 
+#include <QBitArray>
+#include <QCoreApplication>
+#include <QThread>
+#include <QThreadPool>
+
 #include "Wallet.h"
+#include "utils/ScopeGuard.h"
 #include <wallet/wallet2.h>
 
+namespace {
+    // Addresses are derived and encoded in pages of this many rows, a page fills a screen a few times over
+    constexpr qsizetype PAGE_SIZE = 128;
+
+    // The integrity sweep checks subaddresses in chunks of this many rows, one chunk per task
+    constexpr quint32 VERIFY_CHUNK_SIZE = 1024;
+
+    // Shared by all open wallets, so sweeping several wallets at once doesn't start a full pool for each of them
+    QThreadPool* verifyPool() {
+        static QThreadPool *pool = [] {
+            auto *pool = new QThreadPool(QCoreApplication::instance());
+            pool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+            return pool;
+        }();
+        return pool;
+    }
+}
+
 Subaddress::Subaddress(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent)
     : QObject(parent)
     , m_wallet(wallet)
     , m_wallet2(wallet2)
+    , m_scheduler(this)
 {
     QString pinned = m_wallet->getCacheAttribute("feather.pinnedaddresses");
-    m_pinned = pinned.split(",");
+    m_pinned = pinned.split(",", Qt::SkipEmptyParts);
 
     QString hidden = m_wallet->getCacheAttribute("feather.hiddenaddresses");
-    m_hidden = hidden.split(",");
+    m_hidden = hidden.split(",", Qt::SkipEmptyParts);
 
     connect(this, &Subaddress::noUnusedSubaddresses, [this] {
         this->addRow("");
     });
+
+    connect(this, &Subaddress::addressesDerived, this, &Subaddress::onAddressesDerived, Qt::QueuedConnection);
+    connect(this, &Subaddress::addressesVerified, this, &Subaddress::onAddressesVerified, Qt::QueuedConnection);
 }
 
 bool Subaddress::refresh()
@@ -27,26 +55,45 @@ bool Subaddress::refresh()
     emit refreshStarted();
 
     m_rows.clear();
+    m_pendingPages.clear();
+    m_generation += 1;
+    m_accountIndex = m_wallet->currentSubaddressAccount();
 
-    bool potentialWalletFileCorruption = false;
+    // Once a check failed no address is shown again until the wallet is reopened, even if verify_keys passes
+    if (m_corrupted) {
+        emit corrupted();
+        emit refreshFinished();
+        return false;
+    }
 
-    quint32 accountIndex = m_wallet->currentSubaddressAccount();
-    for (quint32 i = 0; i < m_wallet2->get_num_subaddresses(accountIndex); ++i)
-    {
-        bool r = emplaceRow(i);
-        if (!r) {
-            potentialWalletFileCorruption = true;
-            break;
-        }
+    // Rows start out without an address, deriving and encoding every subaddress up front is what made
+    // this slow on wallets with many subaddresses. Addresses are filled in page by page as rows are shown.
+    quint32 numSubaddresses = m_wallet2->get_num_subaddresses(m_accountIndex);
+    m_rows.reserve(numSubaddresses);
+    for (quint32 i = 0; i < numSubaddresses; ++i) {
+        m_rows.emplace_back(
+            QString(),
+            QString::fromStdString(m_wallet2->get_subaddress_label({m_accountIndex, i})),
+            false,
+            false,
+            false,
+            i == 0
+        );
     }
 
+    this->scanTransfers(true);
+    this->applyMarks(m_hidden, &SubaddressRow::hidden);
+    this->applyMarks(m_pinned, &SubaddressRow::pinned);
+
     // Make sure keys are intact. We NEVER want to display incorrect addresses in case of memory corruption.
-    potentialWalletFileCorruption = potentialWalletFileCorruption || (m_wallet2->get_device_type() == hw::device::SOFTWARE && !m_wallet2->verify_keys());
+    // The subaddress mapping is verified for every row when its page is derived.
+    bool potentialWalletFileCorruption = (m_wallet2->get_device_type() == hw::device::SOFTWARE && !m_wallet2->verify_keys());
 
     if (potentialWalletFileCorruption) {
-        LOG_ERROR("KEY INCONSISTENCY DETECTED, WALLET IS IN CORRUPT STATE.");
-        m_rows.clear();
-        emit corrupted();
+        this->markCorrupted();
+    }
+    else {
+        this->verifyAddresses();
     }
 
     emit refreshFinished();
@@ -56,17 +103,17 @@ bool Subaddress::refresh()
 
 void Subaddress::updateUsed(quint32 accountIndex)
 {
-    bool haveUnused = false;
-    for (quint32 i = 0; i < m_rows.count(); i++) {
-        SubaddressRow& row = m_rows[i];
+    if (accountIndex != m_accountIndex) {
+        return;
+    }
 
-        bool used = m_wallet2->get_subaddress_used({accountIndex, i});
-        if (used != row.used) {
-            row.used = !row.used;
-            emit rowUpdated(i);
-        }
-        if (!used && i > 0) {
+    this->scanTransfers(false);
+
+    bool haveUnused = false;
+    for (qsizetype i = 1; i < m_rows.count(); i++) {
+        if (!m_rows[i].used) {
             haveUnused = true;
+            break;
         }
     }
     if (!haveUnused) {
@@ -74,6 +121,51 @@ void Subaddress::updateUsed(quint32 accountIndex)
     }
 }
 
+void Subaddress::scanTransfers(bool rescan)
+{
+    // A subaddress is used once it has received a transfer. Transfers are only ever appended, except when
+    // a reorg detaches blocks, which we notice by the last transfer we saw having changed or disappeared.
+    size_t numTransfers = m_wallet2->get_num_transfer_details();
+    if (!rescan && m_transfersScanned > 0) {
+        if (numTransfers < m_transfersScanned) {
+            rescan = true;
+        }
+        else {
+            const crypto::hash &txid = m_wallet2->get_transfer_details(m_transfersScanned - 1).m_txid;
+            rescan = (m_lastTransferTxid != QByteArray(txid.data, sizeof(txid.data)));
+        }
+    }
+
+    size_t begin = rescan ? 0 : m_transfersScanned;
+    if (begin == numTransfers && !rescan) {
+        return;
+    }
+
+    QBitArray used(m_rows.size());
+    for (size_t i = begin; i < numTransfers; ++i) {
+        const cryptonote::subaddress_index &index = m_wallet2->get_transfer_details(i).m_subaddr_index;
+        if (index.major == m_accountIndex && index.minor < static_cast<quint32>(used.size())) {
+            used.setBit(index.minor);
+        }
+    }
+
+    for (qsizetype i = 0; i < m_rows.size(); ++i) {
+        SubaddressRow &row = m_rows[i];
+        // Incremental scans can only add used flags, a rescan also clears flags of detached transfers
+        bool isUsed = used.testBit(i) || (!rescan && row.used);
+        if (isUsed != row.used) {
+            row.used = isUsed;
+            emit rowUpdated(i);
+        }
+    }
+
+    m_transfersScanned = numTransfers;
+    if (numTransfers > 0) {
+        const crypto::hash &txid = m_wallet2->get_transfer_details(numTransfers - 1).m_txid;
+        m_lastTransferTxid = QByteArray(txid.data, sizeof(txid.data));
+    }
+}
+
 qsizetype Subaddress::count() const
 {
     return m_rows.length();
@@ -97,38 +189,240 @@ const QList<SubaddressRow>& Subaddress::getRows()
     return m_rows;
 }
 
-bool Subaddress::emplaceRow(quint32 addressIndex)
+void Subaddress::requestAddress(qsizetype index)
 {
-    cryptonote::subaddress_index index = {m_wallet->currentSubaddressAccount(), addressIndex};
-    cryptonote::account_public_address address = m_wallet2->get_subaddress(index);
+    if (index < 0 || index >= m_rows.size() || !m_rows[index].address.isEmpty()) {
+        return;
+    }
+    this->derivePage(index / PAGE_SIZE);
+}
 
-    // Make sure we have previously generated Di
-    auto idx =  m_wallet2->get_subaddress_index(address);
-    if (!idx) {
-        return false;
+void Subaddress::requestAllAddresses()
+{
+    for (qsizetype page = 0; page * PAGE_SIZE < m_rows.size(); ++page) {
+        qsizetype last = std::min((page + 1) * PAGE_SIZE, m_rows.size()) - 1;
+        if (m_rows[last].address.isEmpty()) {
+            this->derivePage(page);
+        }
     }
+}
 
-    // Verify mapping
-    if (idx != index) {
-        return false;
+void Subaddress::derivePage(qsizetype page)
+{
+    if (m_pendingPages.contains(page)) {
+        return;
     }
 
-    if (m_rows.length() != addressIndex) {
-        return false;
+    quint64 generation = m_generation;
+    quint32 accountIndex = m_accountIndex;
+    quint32 first = page * PAGE_SIZE;
+    quint32 last = std::min((page + 1) * PAGE_SIZE, m_rows.size());
+    quint32 verifiedThrough = this->verifiedThrough(accountIndex);
+
+    auto r = m_scheduler.run([this, generation, accountIndex, first, last, verifiedThrough] {
+        std::vector<cryptonote::account_public_address> derived;
+        derived.reserve(last - first);
+        for (quint32 i = first; i < last; ++i) {
+            derived.push_back(m_wallet2->get_subaddress({accountIndex, i}));
+        }
+
+        // Make sure we have previously generated Di and verify the mapping, the sweep already did for rows below
+        // the watermark. The refresh thread adds subaddresses to the lookup table, only read it while holding the
+        // wallet, in one pass after the derivation.
+        bool ok = true;
+        if (verifiedThrough < last) {
+            while (!m_wallet->m_asyncMutex.tryLock(100)) {
+                if (m_scheduler.stopping()) {
+                    return;
+                }
+            }
+            const auto unlock = sg::make_scope_guard([this]() noexcept {
+                m_wallet->m_asyncMutex.unlock();
+            });
+
+            for (quint32 i = std::max(first, verifiedThrough); i < last; ++i) {
+                auto idx = m_wallet2->get_subaddress_index(derived[i - first]);
+                if (!idx || idx->major != accountIndex || idx->minor != i) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+
+        QStringList addresses;
+        if (ok) {
+            for (quint32 i = first; i < last; ++i) {
+                addresses << QString::fromStdString(cryptonote::get_account_address_as_str(m_wallet2->nettype(), i != 0 || accountIndex != 0, derived[i - first]));
+            }
+        }
+
+        emit addressesDerived(generation, first, addresses, ok);
+    });
+
+    if (r.first) {
+        m_pendingPages.insert(page);
     }
+}
 
-    QString addressStr = QString::fromStdString(cryptonote::get_account_address_as_str(m_wallet2->nettype(), !index.is_zero(), address));
+void Subaddress::onAddressesDerived(quint64 generation, quint32 first, const QStringList &addresses, bool ok)
+{
+    if (generation != m_generation) {
+        return;
+    }
 
-    bool used = m_wallet2->get_subaddress_used(index);
-    m_rows.emplace_back(
-        addressStr,
-        QString::fromStdString(m_wallet2->get_subaddress_label(index)),
-        used,
-        this->isHidden(addressStr),
-        this->isPinned(addressStr),
-        index.is_zero()
-    );
-    return true;
+    if (!ok) {
+        emit refreshStarted();
+        this->markCorrupted();
+        emit refreshFinished();
+        return;
+    }
+
+    m_pendingPages.remove(first / PAGE_SIZE);
+
+    if (addresses.isEmpty() || first + addresses.size() > m_rows.size()) {
+        return;
+    }
+
+    for (qsizetype i = 0; i < addresses.size(); ++i) {
+        m_rows[first + i].address = addresses[i];
+    }
+
+    emit rowsUpdated(first, first + addresses.size() - 1);
+}
+
+quint32 Subaddress::verifiedThrough(quint32 accountIndex) const
+{
+    return m_verifiedThrough.value(accountIndex, 0);
+}
+
+void Subaddress::verifyAddresses()
+{
+    // Deriving subaddresses on a hardware device goes through the device one request at a time
+    if (m_wallet2->get_device_type() != hw::device::SOFTWARE) {
+        return;
+    }
+
+    quint32 accountIndex = m_accountIndex;
+    quint32 first = this->verifiedThrough(accountIndex);
+    quint32 last = m_rows.size();
+    if (m_corrupted || first >= last || m_verifying.contains(accountIndex)) {
+        return;
+    }
+
+    auto r = m_scheduler.run([this, accountIndex, first, last] {
+        enum ChunkResult : char { Skipped, Verified, Mismatch };
+
+        QVector<quint32> chunks;
+        for (quint32 i = first; i < last; i += VERIFY_CHUNK_SIZE) {
+            chunks.append(i);
+        }
+        std::vector<ChunkResult> results(chunks.size(), Skipped);
+        std::vector<cryptonote::account_public_address> addresses(last - first);
+
+        // Deriving only reads the wallet's keys, the expensive part runs in parallel without holding up a refresh
+        auto verifyChunk = [&](quint32 chunkFirst) {
+            const quint32 chunkLast = std::min(chunkFirst + VERIFY_CHUNK_SIZE, last);
+            ChunkResult &result = results[(chunkFirst - first) / VERIFY_CHUNK_SIZE];
+
+            // Leave the rest unverified when the wallet closes, that is not a mismatch
+            if (m_scheduler.stopping()) {
+                return;
+            }
+
+            for (quint32 i = chunkFirst; i < chunkLast; ++i) {
+                cryptonote::subaddress_index index = {accountIndex, i};
+                cryptonote::account_public_address &address = addresses[i - first];
+                address = m_wallet2->get_subaddress(index);
+
+                // The same key checks as Wallet::getAddressSafe
+                if (address != m_wallet2->get_subaddress(index)
+                        || !rct::isInMainSubgroup(rct::pk2rct(address.m_spend_public_key))
+                        || !rct::isInMainSubgroup(rct::pk2rct(address.m_view_public_key))) {
+                    result = Mismatch;
+                    return;
+                }
+            }
+
+            result = Verified;
+        };
+
+        QtConcurrent::blockingMap(verifyPool(), chunks, verifyChunk);
+
+        // The watermark only covers the verified chunks up to the first one that was skipped
+        bool ok = true;
+        quint32 verifiedThrough = first;
+        bool contiguous = true;
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i] == Mismatch) {
+                ok = false;
+            }
+            if (results[i] != Verified) {
+                contiguous = false;
+            }
+            if (contiguous) {
+                verifiedThrough = std::min(chunks[i] + VERIFY_CHUNK_SIZE, last);
+            }
+        }
+
+        if (ok && verifiedThrough > first) {
+            // The refresh thread adds subaddresses to the lookup table, only read it while holding the wallet
+            while (!m_wallet->m_asyncMutex.tryLock(100)) {
+                if (m_scheduler.stopping()) {
+                    return;
+                }
+            }
+            const auto unlock = sg::make_scope_guard([this]() noexcept {
+                m_wallet->m_asyncMutex.unlock();
+            });
+
+            // Make sure we have previously generated Di and verify the mapping
+            for (quint32 i = first; i < verifiedThrough; ++i) {
+                auto idx = m_wallet2->get_subaddress_index(addresses[i - first]);
+                if (!idx || idx->major != accountIndex || idx->minor != i) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+
+        emit addressesVerified(accountIndex, verifiedThrough, ok);
+    });
+
+    if (r.first) {
+        m_verifying.insert(accountIndex);
+    }
+}
+
+void Subaddress::onAddressesVerified(quint32 accountIndex, quint32 verifiedThrough, bool ok)
+{
+    m_verifying.remove(accountIndex);
+
+    if (m_corrupted) {
+        return;
+    }
+
+    // A mismatch in any account means the wallet can't be trusted, whichever account is shown now
+    if (!ok) {
+        emit refreshStarted();
+        this->markCorrupted();
+        emit refreshFinished();
+        return;
+    }
+
+    if (verifiedThrough > this->verifiedThrough(accountIndex)) {
+        m_verifiedThrough[accountIndex] = verifiedThrough;
+    }
+}
+
+void Subaddress::markCorrupted()
+{
+    LOG_ERROR("KEY INCONSISTENCY DETECTED, WALLET IS IN CORRUPT STATE.");
+    m_rows.clear();
+    m_pendingPages.clear();
+    m_verifiedThrough.clear();
+    m_corrupted = true;
+    m_generation += 1;
+    emit corrupted();
 }
 
 bool Subaddress::addRow(const QString &label)
@@ -137,12 +431,15 @@ bool Subaddress::addRow(const QString &label)
     // Todo: Notify GUI that it was a device error
     try
     {
-        quint32 addressIndex = m_wallet->numSubaddresses(m_wallet->currentSubaddressAccount());
-        m_wallet2->add_subaddress(m_wallet->currentSubaddressAccount(), label.toStdString());
+        quint32 addressIndex = m_wallet->numSubaddresses(m_accountIndex);
+        m_wallet2->add_subaddress(m_accountIndex, label.toStdString());
 
         emit beginAddRow(addressIndex);
-        emplaceRow(addressIndex);
+        m_rows.emplace_back(QString(), label, false, false, false, addressIndex == 0);
         emit endAddRow();
+
+        // A page that was derived before this row existed will not include it
+        m_pendingPages.remove(addressIndex / PAGE_SIZE);
     }
     catch (const std::exception& e)
     {
@@ -158,7 +455,7 @@ bool Subaddress::addRow(const QString &label)
 bool Subaddress::setLabel(quint32 addressIndex, const QString &label)
 {
     try {
-        m_wallet2->set_subaddress_label({m_wallet->currentSubaddressAccount(), addressIndex}, label.toStdString());
+        m_wallet2->set_subaddress_label({m_accountIndex, addressIndex}, label.toStdString());
         SubaddressRow& row = m_rows[addressIndex];
         row.label = label;
         emit rowUpdated(addressIndex);
@@ -171,56 +468,81 @@ bool Subaddress::setLabel(quint32 addressIndex, const QString &label)
     return true;
 }
 
-bool Subaddress::setHidden(const QString &address, bool hidden) 
+bool Subaddress::setHidden(quint32 addressIndex, bool hidden)
 {
-    if (hidden) {
-        if (m_hidden.contains(address)) {
-            return false;
-        }
-        m_hidden.append(address);
+    if (!this->setMark(m_hidden, "feather.hiddenaddresses", addressIndex, hidden)) {
+        return false;
     }
-    else {
-        if (!m_hidden.contains(address)) {
-            return false;
-        }
-        m_hidden.removeAll(address);
+    m_rows[addressIndex].hidden = hidden;
+    emit rowUpdated(addressIndex);
+    return true;
+}
+
+bool Subaddress::setPinned(quint32 addressIndex, bool pinned)
+{
+    if (!this->setMark(m_pinned, "feather.pinnedaddresses", addressIndex, pinned)) {
+        return false;
     }
-    
-    bool r = m_wallet->setCacheAttribute("feather.hiddenaddresses", m_hidden.join(","));
-    
-    refresh();
-    return r;
+    m_rows[addressIndex].pinned = pinned;
+    emit rowUpdated(addressIndex);
+    return true;
 }
 
-bool Subaddress::setPinned(const QString &address, bool pinned)
+bool Subaddress::setMark(QStringList &addresses, const QString &attribute, quint32 addressIndex, bool enabled)
 {
-    if (pinned) {
-        if (m_pinned.contains(address)) {
+    if (addressIndex >= m_rows.size()) {
+        return false;
+    }
+
+    // Pins and hides are stored by address, the row may not have been derived yet
+    bool ok;
+    QString reason;
+    QString address = m_wallet->getAddressSafe(m_accountIndex, addressIndex, ok, reason);
+    if (!ok) {
+        m_errorString = reason;
+        return false;
+    }
+
+    if (enabled) {
+        if (addresses.contains(address)) {
             return false;
         }
-        m_pinned.append(address);
+        addresses.append(address);
     }
     else {
-        if (!m_pinned.contains(address)) {
+        if (!addresses.contains(address)) {
             return false;
         }
-        m_pinned.removeAll(address);
+        addresses.removeAll(address);
     }
 
-    bool r = m_wallet->setCacheAttribute("feather.pinnedaddresses", m_pinned.join(","));
-
-    refresh();
-    return r;
+    return m_wallet->setCacheAttribute(attribute, addresses.join(","));
 }
 
-bool Subaddress::isHidden(const QString &address) 
+void Subaddress::applyMarks(const QStringList &addresses, bool SubaddressRow::*flag)
 {
-    return m_hidden.contains(address);
+    for (const auto &address : addresses) {
+        qsizetype index = this->indexOf(address);
+        if (index >= 0) {
+            m_rows[index].*flag = true;
+        }
+    }
 }
 
-bool Subaddress::isPinned(const QString &address)
+qsizetype Subaddress::indexOf(const QString &address) const
 {
-    return m_pinned.contains(address);
+    // Looks up the row of an address in the current account without deriving any addresses
+    cryptonote::address_parse_info info;
+    if (!cryptonote::get_account_address_from_str(info, m_wallet2->nettype(), address.toStdString())) {
+        return -1;
+    }
+
+    auto index = m_wallet2->get_subaddress_index(info.address);
+    if (!index || index->major != m_accountIndex || index->minor >= m_rows.size()) {
+        return -1;
+    }
+
+    return index->minor;
 }
 
 QString Subaddress::getError() const {
@@ -5,9 +5,11 @@
 #define SUBADDRESS_H
 
 #include <QObject>
+#include <QSet>
 #include <QString>
 
 #include "rows/SubaddressRow.h"
+#include "utils/scheduler.h"
 
 namespace tools {
     class wallet2;
@@ -27,12 +29,18 @@ public:
     const SubaddressRow& getRow(qsizetype i);
     const QList<SubaddressRow>& getRows();
 
+    //! Rows are created without an address, this derives the page that contains the row in the background
+    void requestAddress(qsizetype index);
+    //! Derives all addresses that are not derived yet, the address search needs every row
+    void requestAllAddresses();
+
+    //! Rows of the account below this index passed the full integrity check in the background sweep
+    quint32 verifiedThrough(quint32 accountIndex) const;
+
     bool addRow(const QString &label);
     bool setLabel(quint32 addressIndex, const QString &label);
-    bool setHidden(const QString& address, bool hidden);
-    bool setPinned(const QString& address, bool pinned);
-    bool isHidden(const QString& address);
-    bool isPinned(const QString& address);
+    bool setHidden(quint32 addressIndex, bool hidden);
+    bool setPinned(quint32 addressIndex, bool pinned);
 
     QString getError() const;
 
@@ -40,25 +48,56 @@ signals:
     void refreshStarted() const;
     void refreshFinished() const;
     void rowUpdated(qsizetype index) const;
+    void rowsUpdated(qsizetype first, qsizetype last) const;
     void corrupted() const;
     void noUnusedSubaddresses() const;
     void beginAddRow(qsizetype index) const;
     void endAddRow() const;
 
-private:
-    bool emplaceRow(quint32 addressIndex);
+    // Emitted from the worker thread, delivered to onAddressesDerived on the GUI thread
+    void addressesDerived(quint64 generation, quint32 first, const QStringList &addresses, bool ok) const;
+    void addressesVerified(quint32 accountIndex, quint32 verifiedThrough, bool ok) const;
 
+private:
     explicit Subaddress(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent);
     friend class Wallet;
 
+    void derivePage(qsizetype page);
+    void onAddressesDerived(quint64 generation, quint32 first, const QStringList &addresses, bool ok);
+    void verifyAddresses();
+    void onAddressesVerified(quint32 accountIndex, quint32 verifiedThrough, bool ok);
+    void markCorrupted();
+
+    void scanTransfers(bool rescan);
+    void applyMarks(const QStringList &addresses, bool SubaddressRow::*flag);
+    qsizetype indexOf(const QString &address) const;
+    bool setMark(QStringList &addresses, const QString &attribute, quint32 addressIndex, bool enabled);
+
     Wallet* m_wallet;
     tools::wallet2 *m_wallet2;
     QList<SubaddressRow> m_rows;
-    
+    quint32 m_accountIndex = 0;
+
+    // Bumped on every refresh, so pages derived for a previous account or row set are dropped
+    quint64 m_generation = 0;
+    QSet<qsizetype> m_pendingPages;
+
+    // Verified-through watermark per account, subaddresses are only ever appended so it stays valid while the
+    // wallet is open
+    QHash<quint32, quint32> m_verifiedThrough;
+    QSet<quint32> m_verifying;
+    bool m_corrupted = false; // Nothing is trusted anymore once a check failed
+
+    // Transfers already folded into the used flags, only transfers past this point are scanned
+    size_t m_transfersScanned = 0;
+    QByteArray m_lastTransferTxid;
+
     QStringList m_pinned;
     QStringList m_hidden;
 
     QString m_errorString;
+
+    FutureScheduler m_scheduler;
 };
 
 #endif // SUBADDRESS_H
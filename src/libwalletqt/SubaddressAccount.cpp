@@ -2,11 +2,13 @@
 // SPDX-FileCopyrightText: The Monero Project
 
 #include "SubaddressAccount.h"
+#include "BalanceCache.h"
 #include <wallet/wallet2.h>
 
-SubaddressAccount::SubaddressAccount(tools::wallet2 *wallet2, QObject *parent)
+SubaddressAccount::SubaddressAccount(tools::wallet2 *wallet2, BalanceCache *balanceCache, QObject *parent)
     : QObject(parent)
     , m_wallet2(wallet2)
+    , m_balanceCache(balanceCache)
 {
 }
 
@@ -16,13 +18,16 @@ void SubaddressAccount::refresh()
 
     m_rows.clear();
 
+    const QList<BalanceAmounts> balances = m_balanceCache->accounts();
+
     for (uint32_t i = 0; i < m_wallet2->get_num_subaddress_accounts(); ++i)
     {
+        const BalanceAmounts amounts = balances.value(i);
         m_rows.emplace_back(
             QString::fromStdString(m_wallet2->get_subaddress_as_str({i,0})),
             QString::fromStdString(m_wallet2->get_subaddress_label({i,0})),
-            m_wallet2->balance(i, false),
-            m_wallet2->unlocked_balance(i, false));
+            amounts.balance,
+            amounts.unlocked);
     }
 
     emit refreshFinished();
@@ -13,6 +13,7 @@ namespace tools {
     class wallet2;
 }
 
+class BalanceCache;
 class SubaddressAccount : public QObject
 {
     Q_OBJECT
@@ -32,10 +33,11 @@ signals:
     void refreshFinished() const;
 
 private:
-    explicit SubaddressAccount(tools::wallet2 *wallet2, QObject *parent);
+    explicit SubaddressAccount(tools::wallet2 *wallet2, BalanceCache *balanceCache, QObject *parent);
     friend class Wallet;
 
     tools::wallet2 *m_wallet2;
+    BalanceCache *m_balanceCache;
     QList<AccountRow> m_rows;
 };
 
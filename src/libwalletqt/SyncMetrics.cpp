@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "SyncMetrics.h"
+
+#include <QDateTime>
+
+#include "Wallet.h"
+
+namespace {
+    // One hour of samples at the sample interval
+    constexpr int MAX_SAMPLES = 3600;
+    constexpr int SAMPLE_INTERVAL_MSECS = 1000;
+}
+
+SyncMetrics::SyncMetrics(Wallet *wallet, QObject *parent)
+        : QObject(parent)
+        , m_wallet(wallet)
+{
+    connect(m_wallet, &Wallet::syncStatus, this, &SyncMetrics::onSyncStatus);
+    connect(m_wallet, &Wallet::heightsRefreshed, this, &SyncMetrics::onHeightsRefreshed);
+
+    // Blocks are not reported while the wallet downloads hashes, sample on a timer so the byte counter keeps moving
+    connect(&m_sampleTimer, &QTimer::timeout, this, &SyncMetrics::sample);
+    m_sampleTimer.start(SAMPLE_INTERVAL_MSECS);
+}
+
+void SyncMetrics::onSyncStatus(quint64 height, quint64 target, bool daemonSync) {
+    if (daemonSync) {
+        // Daemon is still syncing, these are daemon heights
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_height = height;
+    m_targetHeight = target;
+}
+
+void SyncMetrics::onHeightsRefreshed(bool success, quint64 daemonHeight, quint64 targetHeight) {
+    Q_UNUSED(daemonHeight)
+    if (!success) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_targetHeight = targetHeight;
+}
+
+void SyncMetrics::sample() {
+    auto status = m_wallet->connectionStatus();
+    if (status != Wallet::ConnectionStatus_Synchronizing && status != Wallet::ConnectionStatus_Connecting) {
+        return;
+    }
+
+    SyncSample sample;
+    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+    sample.bytesReceived = m_wallet->getBytesReceived();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        sample.height = m_height;
+        sample.targetHeight = m_targetHeight;
+        sample.refreshMsecs = this->refreshMsecsLocked();
+        sample.modelMsecs = m_modelMsecs;
+
+        m_timeline.append(sample);
+        if (m_timeline.size() > MAX_SAMPLES) {
+            m_timeline.removeFirst();
+        }
+    }
+
+    emit metricsUpdated();
+}
+
+const SyncSample* SyncMetrics::windowStart() const {
+    if (m_timeline.size() < 2) {
+        return nullptr;
+    }
+
+    const qint64 cutoff = m_timeline.last().timestamp - WINDOW_MSECS;
+    for (const auto &sample : m_timeline) {
+        if (sample.timestamp >= cutoff) {
+            return &sample;
+        }
+    }
+    return nullptr;
+}
+
+qint64 SyncMetrics::refreshMsecsLocked() const {
+    // A single refresh can take the whole sync, count the part that has already passed
+    if (m_refreshTimer.isValid()) {
+        return m_refreshMsecs + m_refreshTimer.elapsed();
+    }
+    return m_refreshMsecs;
+}
+
+double SyncMetrics::blocksPerSecond() const {
+    QMutexLocker locker(&m_mutex);
+    const SyncSample *start = this->windowStart();
+    if (!start) {
+        return 0;
+    }
+
+    const SyncSample &end = m_timeline.last();
+    qint64 msecs = end.timestamp - start->timestamp;
+    if (msecs <= 0 || end.height <= start->height) {
+        return 0;
+    }
+    return (end.height - start->height) * 1000.0 / msecs;
+}
+
+double SyncMetrics::bytesPerSecond() const {
+    QMutexLocker locker(&m_mutex);
+    const SyncSample *start = this->windowStart();
+    if (!start) {
+        return 0;
+    }
+
+    const SyncSample &end = m_timeline.last();
+    qint64 msecs = end.timestamp - start->timestamp;
+    if (msecs <= 0 || end.bytesReceived <= start->bytesReceived) {
+        return 0;
+    }
+    return (end.bytesReceived - start->bytesReceived) * 1000.0 / msecs;
+}
+
+qint64 SyncMetrics::eta() const {
+    double rate = this->blocksPerSecond();
+
+    QMutexLocker locker(&m_mutex);
+    if (rate <= 0 || m_targetHeight <= m_height + 1) {
+        return -1;
+    }
+    return static_cast<qint64>((m_targetHeight - m_height - 1) / rate);
+}
+
+QPair<qint64, qint64> SyncMetrics::timeBreakdown() const {
+    QMutexLocker locker(&m_mutex);
+    const SyncSample *start = this->windowStart();
+    if (!start) {
+        return {0, 0};
+    }
+
+    const SyncSample &end = m_timeline.last();
+    return {end.refreshMsecs - start->refreshMsecs, end.modelMsecs - start->modelMsecs};
+}
+
+QList<SyncSample> SyncMetrics::timeline() const {
+    QMutexLocker locker(&m_mutex);
+    return m_timeline;
+}
+
+QString SyncMetrics::timelineCsv() const {
+    auto timeline = this->timeline();
+
+    QString csv = "timestamp,height,target_height,bytes_received,refresh_ms,model_ms\n";
+    for (const auto &sample : timeline) {
+        csv += QString("%1,%2,%3,%4,%5,%6\n").arg(QString::number(sample.timestamp),
+                                                  QString::number(sample.height),
+                                                  QString::number(sample.targetHeight),
+                                                  QString::number(sample.bytesReceived),
+                                                  QString::number(sample.refreshMsecs),
+                                                  QString::number(sample.modelMsecs));
+    }
+    return csv;
+}
+
+void SyncMetrics::refreshStarted() {
+    QMutexLocker locker(&m_mutex);
+    m_refreshTimer.start();
+}
+
+void SyncMetrics::refreshFinished() {
+    QMutexLocker locker(&m_mutex);
+    if (m_refreshTimer.isValid()) {
+        m_refreshMsecs += m_refreshTimer.elapsed();
+        m_refreshTimer.invalidate();
+    }
+}
+
+void SyncMetrics::addModelTime(qint64 msecs) {
+    QMutexLocker locker(&m_mutex);
+    m_modelMsecs += msecs;
+}
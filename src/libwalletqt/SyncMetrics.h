@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_SYNCMETRICS_H
+#define FEATHER_SYNCMETRICS_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QTimer>
+
+class Wallet;
+
+struct SyncSample {
+    qint64 timestamp = 0; // msecs since epoch
+    quint64 height = 0;
+    quint64 targetHeight = 0;
+    quint64 bytesReceived = 0;
+    qint64 refreshMsecs = 0; // cumulative time spent in wallet2 refresh
+    qint64 modelMsecs = 0;   // cumulative time spent rebuilding models
+};
+
+// Collects a timeline of synchronization progress for a wallet and derives throughput over a rolling window.
+class SyncMetrics : public QObject
+{
+Q_OBJECT
+
+public:
+    //! Rolling window used for rates and the refresh / model breakdown
+    static constexpr qint64 WINDOW_MSECS = 30 * 1000;
+
+    double blocksPerSecond() const;
+    double bytesPerSecond() const;
+
+    //! Seconds until the wallet reaches the target height, -1 if unknown
+    qint64 eta() const;
+
+    //! Time spent in refresh and in model rebuilds during the rolling window, in msecs
+    QPair<qint64, qint64> timeBreakdown() const;
+
+    QList<SyncSample> timeline() const;
+    QString timelineCsv() const;
+
+    // Can be called from any thread
+    void refreshStarted();
+    void refreshFinished();
+    void addModelTime(qint64 msecs);
+
+signals:
+    void metricsUpdated();
+
+private:
+    explicit SyncMetrics(Wallet *wallet, QObject *parent = nullptr);
+    friend class Wallet;
+
+    void onSyncStatus(quint64 height, quint64 target, bool daemonSync);
+    void onHeightsRefreshed(bool success, quint64 daemonHeight, quint64 targetHeight);
+    void sample();
+
+    //! Oldest sample inside the rolling window, caller must hold m_mutex
+    const SyncSample* windowStart() const;
+    qint64 refreshMsecsLocked() const;
+
+    Wallet *m_wallet;
+    QTimer m_sampleTimer;
+
+    mutable QMutex m_mutex;
+    QList<SyncSample> m_timeline;
+    quint64 m_height = 0;
+    quint64 m_targetHeight = 0;
+    qint64 m_refreshMsecs = 0;
+    qint64 m_modelMsecs = 0;
+    QElapsedTimer m_refreshTimer;
+};
+
+#endif //FEATHER_SYNCMETRICS_H
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "SyncScheduler.h"
+
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QThread>
+
+#include <algorithm>
+
+namespace {
+    // Wallets on the same node refresh every 10 seconds, heights younger than this are reused
+    constexpr qint64 DAEMON_HEIGHTS_MAX_AGE_MS = 5 * 1000;
+}
+
+QPointer<SyncScheduler> SyncScheduler::m_instance(nullptr);
+
+SyncScheduler::SyncScheduler(QObject *parent)
+        : QObject(parent)
+        , m_maxConcurrent(std::max(2, QThread::idealThreadCount() / 2))
+{
+}
+
+SyncScheduler* SyncScheduler::instance() {
+    // Wallets are constructed on worker threads, so the first call may not come from the GUI thread
+    static QMutex instanceMutex;
+    QMutexLocker locker(&instanceMutex);
+
+    if (!m_instance) {
+        m_instance = new SyncScheduler;
+        if (m_instance->thread() != qApp->thread()) {
+            m_instance->moveToThread(qApp->thread());
+        }
+    }
+
+    return m_instance;
+}
+
+void SyncScheduler::registerWallet(Wallet *wallet, const QString &walletName) {
+    {
+        QMutexLocker locker(&m_mutex);
+        Entry &entry = m_wallets[wallet];
+        entry.info.walletName = walletName;
+    }
+    emit walletsChanged();
+}
+
+void SyncScheduler::unregisterWallet(Wallet *wallet) {
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_wallets.find(wallet);
+        if (it != m_wallets.end() && it->info.state == WalletSyncInfo::Refreshing) {
+            m_running -= 1;
+        }
+        m_wallets.remove(wallet);
+        if (m_focused == wallet) {
+            m_focused = nullptr;
+        }
+    }
+    m_slotFreed.wakeAll();
+    emit walletsChanged();
+}
+
+bool SyncScheduler::canRun(Wallet *wallet) const {
+    // The focused wallet never waits behind wallets in the background
+    if (wallet == m_focused) {
+        return true;
+    }
+
+    int runningInBackground = m_running;
+    if (m_focused && m_wallets.value(m_focused).info.state == WalletSyncInfo::Refreshing) {
+        runningInBackground -= 1;
+    }
+
+    return runningInBackground < m_maxConcurrent;
+}
+
+bool SyncScheduler::acquire(Wallet *wallet, int timeoutMs) {
+    bool acquired = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_wallets.find(wallet);
+        if (it == m_wallets.end()) {
+            return true;
+        }
+
+        it->info.state = WalletSyncInfo::Waiting;
+
+        QDeadlineTimer deadline(timeoutMs);
+        while (!this->canRun(wallet)) {
+            if (!m_slotFreed.wait(&m_mutex, deadline)) {
+                break;
+            }
+        }
+
+        // The wallet may have been unregistered while we were waiting
+        it = m_wallets.find(wallet);
+        if (it != m_wallets.end() && this->canRun(wallet)) {
+            it->info.state = WalletSyncInfo::Refreshing;
+            m_running += 1;
+            acquired = true;
+        }
+    }
+
+    if (acquired) {
+        emit walletsChanged();
+    }
+    return acquired;
+}
+
+void SyncScheduler::release(Wallet *wallet) {
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_wallets.find(wallet);
+        if (it == m_wallets.end() || it->info.state != WalletSyncInfo::Refreshing) {
+            return;
+        }
+
+        it->info.state = WalletSyncInfo::Idle;
+        it->info.lastRefresh = QDateTime::currentDateTime();
+        m_running -= 1;
+    }
+    m_slotFreed.wakeAll();
+    emit walletsChanged();
+}
+
+QPair<quint64, quint64> SyncScheduler::daemonHeights(Wallet *wallet, const QString &daemonAddress, const std::function<QPair<quint64, quint64>()> &fetch) {
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_wallets.find(wallet);
+        if (it != m_wallets.end()) {
+            it->info.daemonAddress = daemonAddress;
+        }
+
+        auto cached = m_daemonHeights.constFind(daemonAddress);
+        if (!daemonAddress.isEmpty() && cached != m_daemonHeights.constEnd() && cached->age.isValid() && cached->age.elapsed() < DAEMON_HEIGHTS_MAX_AGE_MS) {
+            return {cached->daemonHeight, cached->targetHeight};
+        }
+    }
+
+    auto heights = fetch();
+
+    // Only successful polls are shared, a wallet that fails to reach the node should find out for itself
+    if (!daemonAddress.isEmpty() && heights.first > 0 && heights.second > 0) {
+        QMutexLocker locker(&m_mutex);
+        DaemonHeights &cached = m_daemonHeights[daemonAddress];
+        cached.daemonHeight = heights.first;
+        cached.targetHeight = heights.second;
+        cached.age.start();
+    }
+
+    return heights;
+}
+
+void SyncScheduler::setFocusedWallet(Wallet *wallet) {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_wallets.contains(wallet)) {
+            return;
+        }
+        m_focused = wallet;
+    }
+    m_slotFreed.wakeAll();
+}
+
+void SyncScheduler::setMaxConcurrentRefreshes(int max) {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_maxConcurrent = std::max(1, max);
+    }
+    m_slotFreed.wakeAll();
+}
+
+void SyncScheduler::reportHeight(Wallet *wallet, quint64 height, quint64 targetHeight) {
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_wallets.find(wallet);
+        if (it == m_wallets.end()) {
+            return;
+        }
+
+        Entry &entry = *it;
+        if (height + 1 >= targetHeight) {
+            entry.info.blocksPerSecond = 0;
+        }
+        else if (entry.sinceLastReport.isValid() && height > entry.lastReportedHeight) {
+            double seconds = entry.sinceLastReport.elapsed() / 1000.0;
+            if (seconds > 0) {
+                double rate = (height - entry.lastReportedHeight) / seconds;
+                entry.info.blocksPerSecond = (entry.info.blocksPerSecond > 0) ? 0.8 * entry.info.blocksPerSecond + 0.2 * rate : rate;
+            }
+        }
+
+        entry.lastReportedHeight = height;
+        entry.sinceLastReport.start();
+        entry.info.height = height;
+        entry.info.targetHeight = targetHeight;
+    }
+    emit walletsChanged();
+}
+
+QList<WalletSyncInfo> SyncScheduler::wallets() const {
+    QMutexLocker locker(&m_mutex);
+    QList<WalletSyncInfo> result;
+    for (const auto &entry : m_wallets) {
+        result.append(entry.info);
+    }
+    return result;
+}
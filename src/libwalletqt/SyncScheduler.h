@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_SYNCSCHEDULER_H
+#define FEATHER_SYNCSCHEDULER_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QPointer>
+#include <QWaitCondition>
+
+#include <functional>
+
+class Wallet;
+
+struct WalletSyncInfo {
+    enum State {
+        Idle = 0,
+        Waiting,
+        Refreshing
+    };
+
+    QString walletName;
+    QString daemonAddress;
+    State state = Idle;
+    quint64 height = 0;
+    quint64 targetHeight = 0;
+    double blocksPerSecond = 0;
+    QDateTime lastRefresh;
+};
+
+// Coordinates the refresh threads of all open wallets: caps the number of wallets refreshing at the
+// same time, lets the wallet in the focused window go first and shares daemon height polling between
+// wallets connected to the same node.
+class SyncScheduler : public QObject
+{
+Q_OBJECT
+
+public:
+    static SyncScheduler* instance();
+
+    void registerWallet(Wallet *wallet, const QString &walletName);
+    void unregisterWallet(Wallet *wallet);
+
+    //! Blocks until the wallet may refresh or the timeout expires. Must be paired with release().
+    bool acquire(Wallet *wallet, int timeoutMs);
+    void release(Wallet *wallet);
+
+    //! Returns {daemonHeight, targetHeight}, fetching them only if no wallet on this node did recently
+    QPair<quint64, quint64> daemonHeights(Wallet *wallet, const QString &daemonAddress, const std::function<QPair<quint64, quint64>()> &fetch);
+
+    void setFocusedWallet(Wallet *wallet);
+    void setMaxConcurrentRefreshes(int max);
+
+    //! Called from the GUI thread whenever a wallet reports scan progress
+    void reportHeight(Wallet *wallet, quint64 height, quint64 targetHeight);
+
+    QList<WalletSyncInfo> wallets() const;
+
+signals:
+    void walletsChanged();
+
+private:
+    explicit SyncScheduler(QObject *parent = nullptr);
+
+    struct Entry {
+        WalletSyncInfo info;
+        quint64 lastReportedHeight = 0;
+        QElapsedTimer sinceLastReport;
+    };
+
+    struct DaemonHeights {
+        quint64 daemonHeight = 0;
+        quint64 targetHeight = 0;
+        QElapsedTimer age;
+    };
+
+    bool canRun(Wallet *wallet) const;
+
+    static QPointer<SyncScheduler> m_instance;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_slotFreed;
+    QHash<Wallet*, Entry> m_wallets;
+    QHash<QString, DaemonHeights> m_daemonHeights;
+    Wallet *m_focused = nullptr;
+    int m_running = 0;
+    int m_maxConcurrent;
+};
+
+inline SyncScheduler* syncScheduler()
+{
+    return SyncScheduler::instance();
+}
+
+#endif //FEATHER_SYNCSCHEDULER_H
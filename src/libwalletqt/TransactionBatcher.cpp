@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "TransactionBatcher.h"
+
+#include <QHash>
+#include <QTimer>
+
+#include "PendingTransaction.h"
+#include "Wallet.h"
+
+namespace {
+    // transactionCreated doesn't say who asked for the transaction, so only one batcher per wallet creates a
+    // transaction at a time. The others wait until it lets go. Only used on the GUI thread.
+    QHash<const Wallet*, const TransactionBatcher*> creators;
+    QMultiHash<const Wallet*, TransactionBatcher*> waiters;
+}
+
+TransactionBatcher::TransactionBatcher(Wallet *wallet, QObject *parent)
+        : QObject(parent)
+        , m_wallet(wallet)
+{
+    // Connected before MainWindow confirms and disposes of the transaction
+    connect(m_wallet, &Wallet::transactionCreated, this, &TransactionBatcher::onTransactionCreated);
+    connect(m_wallet, &Wallet::transactionCancelled, this, &TransactionBatcher::onTransactionCancelled);
+    connect(m_wallet, &Wallet::transactionCommitted, this, &TransactionBatcher::onTransactionCommitted);
+}
+
+TransactionBatcher::~TransactionBatcher() {
+    this->stop();
+}
+
+void TransactionBatcher::start(qsizetype count, const CreateFunction &create) {
+    this->stop();
+
+    m_create = create;
+    m_count = count;
+    m_sent = 0;
+    m_tx = nullptr;
+    m_state = State::Idle;
+
+    this->createNext();
+}
+
+void TransactionBatcher::resume() {
+    if (m_state == State::Waiting && !m_waitingForWallet) {
+        this->createNext();
+    }
+}
+
+void TransactionBatcher::stop() {
+    this->release();
+    waiters.remove(m_wallet, this);
+    m_state = State::Idle;
+    m_tx = nullptr;
+    m_count = 0;
+    m_sent = 0;
+}
+
+bool TransactionBatcher::isActive() const {
+    return m_state != State::Idle;
+}
+
+qsizetype TransactionBatcher::count() const {
+    return m_count;
+}
+
+qsizetype TransactionBatcher::sent() const {
+    return m_sent;
+}
+
+void TransactionBatcher::createNext() {
+    if (m_sent >= m_count) {
+        m_state = State::Idle;
+        emit finished();
+        return;
+    }
+
+    m_state = State::Waiting;
+
+    const TransactionBatcher *creator = creators.value(m_wallet, nullptr);
+    m_waitingForWallet = (creator != nullptr && creator != this);
+    if (m_waitingForWallet) {
+        waiters.insert(m_wallet, this);
+        return;
+    }
+
+    creators.insert(m_wallet, this);
+    m_state = State::Creating;
+    if (!m_create(m_sent)) {
+        this->release();
+        m_state = State::Waiting;
+    }
+}
+
+void TransactionBatcher::abandon(const QString &reason) {
+    const qsizetype sent = m_sent;
+    const qsizetype count = m_count;
+
+    this->stop();
+    emit abandoned(sent, count, reason);
+}
+
+void TransactionBatcher::release() {
+    if (creators.value(m_wallet, nullptr) != this) {
+        return;
+    }
+    creators.remove(m_wallet);
+
+    for (TransactionBatcher *waiter : waiters.values(m_wallet)) {
+        waiters.remove(m_wallet, waiter);
+        QTimer::singleShot(0, waiter, [waiter]{
+            if (waiter->m_state == State::Waiting && waiter->m_waitingForWallet) {
+                waiter->createNext();
+            }
+        });
+    }
+}
+
+void TransactionBatcher::onTransactionCreated(PendingTransaction *tx) {
+    // Transactions created elsewhere don't concern us
+    if (m_state != State::Creating) {
+        return;
+    }
+    this->release();
+
+    if (tx->status() != PendingTransaction::Status_Ok) {
+        this->abandon(QString("Transaction %1 could not be created: %2").arg(QString::number(m_sent + 1), tx->errorString()));
+        return;
+    }
+
+    m_tx = tx;
+    m_state = State::Confirming;
+}
+
+void TransactionBatcher::onTransactionCancelled(PendingTransaction *tx) {
+    if (m_state != State::Confirming || tx != m_tx) {
+        return;
+    }
+
+    this->abandon(QString("Transaction %1 was not sent.").arg(QString::number(m_sent + 1)));
+}
+
+void TransactionBatcher::onTransactionCommitted(bool success, PendingTransaction *tx) {
+    if (m_state != State::Confirming || tx != m_tx) {
+        return;
+    }
+    m_tx = nullptr;
+
+    if (!success) {
+        this->abandon(QString("Transaction %1 failed to send: %2").arg(QString::number(m_sent + 1), tx->errorString()));
+        return;
+    }
+
+    m_sent += 1;
+    this->createNext();
+}
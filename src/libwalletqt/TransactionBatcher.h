@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_TRANSACTIONBATCHER_H
+#define FEATHER_TRANSACTIONBATCHER_H
+
+#include <QObject>
+
+#include <functional>
+
+class PendingTransaction;
+class Wallet;
+
+// Sends a series of transactions one after the other: the next transaction is only created once the previous one
+// was committed. Only the transactions the batcher asked for are followed up on, transactions created elsewhere in
+// the meantime are left alone. When a transaction fails to build, is rejected by the user or fails to send, the
+// remaining transactions are not sent and abandoned() says how many already went out.
+class TransactionBatcher : public QObject
+{
+Q_OBJECT
+
+public:
+    //! Starts creating transaction index through one of the Wallet's transaction functions. Returns false to hold
+    //! off for now, the batcher then waits for resume().
+    using CreateFunction = std::function<bool(qsizetype index)>;
+
+    explicit TransactionBatcher(Wallet *wallet, QObject *parent = nullptr);
+    ~TransactionBatcher() override;
+
+    void start(qsizetype count, const CreateFunction &create);
+    //! Tries to create the next transaction again after the create function held off
+    void resume();
+    //! Forgets the remaining transactions without reporting them
+    void stop();
+
+    bool isActive() const;
+    qsizetype count() const;
+    qsizetype sent() const;
+
+signals:
+    void finished();
+    void abandoned(qsizetype sent, qsizetype count, const QString &reason);
+
+private:
+    enum class State {
+        Idle,
+        Waiting,    // the create function held off, or another batcher is creating a transaction on this wallet
+        Creating,
+        Confirming  // created, until it is committed or cancelled
+    };
+
+    void createNext();
+    void abandon(const QString &reason);
+    void release();
+
+    void onTransactionCreated(PendingTransaction *tx);
+    void onTransactionCancelled(PendingTransaction *tx);
+    void onTransactionCommitted(bool success, PendingTransaction *tx);
+
+    Wallet *m_wallet;
+    CreateFunction m_create;
+    State m_state = State::Idle;
+    bool m_waitingForWallet = false;
+    qsizetype m_count = 0;
+    qsizetype m_sent = 0;
+    PendingTransaction *m_tx = nullptr; // only compared, the transaction is owned by whoever confirms it
+};
+
+#endif //FEATHER_TRANSACTIONBATCHER_H
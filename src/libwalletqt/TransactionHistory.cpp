@@ -2,9 +2,16 @@
 // SPDX-FileCopyrightText: The Monero Project
 
 #include "TransactionHistory.h"
+
+#include <QElapsedTimer>
+#include <QSet>
+
+#include <cstring>
+
 #include "utils/Utils.h"
 #include "utils/AppData.h"
 #include "utils/config.h"
+#include "utils/ScopeGuard.h"
 #include "constants.h"
 #include "Wallet.h"
 #include "WalletManager.h"
@@ -16,11 +23,65 @@ TransactionHistory::TransactionHistory(Wallet *wallet, tools::wallet2 *wallet2,
     , m_wallet(wallet)
     , m_wallet2(wallet2)
     , m_locked(false)
+    , m_scheduler(this)
 {
+    connect(this, &TransactionHistory::rowsLoaded, this, &TransactionHistory::onRowsLoaded, Qt::QueuedConnection);
+}
+
+namespace {
+    // Rows share one copy of every label, description and payment id instead of allocating a string per row
+    class StringPool {
+    public:
+        QString intern(const QString &str) {
+            if (str.isEmpty()) {
+                return {};
+            }
+            auto it = m_strings.constFind(str);
+            if (it != m_strings.constEnd()) {
+                return *it;
+            }
+            m_strings.insert(str);
+            return str;
+        }
 
+    private:
+        QSet<QString> m_strings;
+    };
+
+    std::array<char, 32> rawHash(const crypto::hash &hash) {
+        std::array<char, 32> raw;
+        static_assert(sizeof(crypto::hash) == raw.size());
+        std::memcpy(raw.data(), hash.data, raw.size());
+        return raw;
+    }
+
+    crypto::hash toHash(const TransactionRow &row) {
+        crypto::hash hash;
+        std::memcpy(hash.data, row.txid.data(), sizeof(hash.data));
+        return hash;
+    }
+
+    QString paymentId(const crypto::hash &pid) {
+        std::string payment_id = epee::string_tools::pod_to_hex(pid);
+        if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
+            payment_id = payment_id.substr(0,16);
+        return QString::fromStdString(payment_id);
+    }
+
+    template <typename T>
+    QList<Ring> ringsFromDetails(const T &pd) {
+        QList<Ring> rings;
+        for (auto const &r: pd.m_rings)
+        {
+            rings.emplace_back(
+                QString::fromStdString(epee::string_tools::pod_to_hex(r.first)),
+                cryptonote::relative_output_offsets_to_absolute(r.second));
+        }
+        return rings;
+    }
 }
 
-QString description(tools::wallet2 *wallet2, const tools::wallet2::payment_details &pd)
+QString description(tools::wallet2 *wallet2, const tools::wallet2::payment_details &pd, const QString &label)
 {
     QString description = QString::fromStdString(wallet2->get_tx_note(pd.m_tx_hash));
     if (description.isEmpty()) {
@@ -31,7 +92,7 @@ QString description(tools::wallet2 *wallet2, const tools::wallet2::payment_detai
             description = "Primary address";
         }
         else {
-            description = QString::fromStdString(wallet2->get_subaddress_label(pd.m_subaddr_index));
+            description = label;
         }
     }
     return description;
@@ -41,222 +102,342 @@ void TransactionHistory::refresh()
 {
     qDebug() << Q_FUNC_INFO;
 
+    // Not shown yet, load() fills the rows the first time
+    if (!m_loaded) {
+        if (m_loading) {
+            m_refreshPending = true;
+        }
+        return;
+    }
+
+    QList<TransactionRow> rows = this->fetchRows();
+
     emit refreshStarted();
 
     {
         QWriteLocker locker(&m_lock);
-
-        m_rows.clear();
-
-        quint64 lastTxHeight = 0;
-        bool hasFakePaymentId = m_wallet->isTrezor();
+        m_rows = std::move(rows);
         m_locked = false;
+    }
 
-        uint64_t min_height = 0;
-        uint64_t max_height = (uint64_t)-1;
-        uint64_t wallet_height = m_wallet->blockChainHeight();
-        uint32_t account = m_wallet->currentSubaddressAccount();
+    emit refreshFinished();
+}
 
-        // transactions are stored in wallet2:
-        // - confirmed_transfer_details   - out transfers
-        // - unconfirmed_transfer_details - pending out transfers
-        // - payment_details              - input transfers
+void TransactionHistory::load()
+{
+    if (m_loaded || m_loading) {
+        return;
+    }
 
-        // payments are "input transactions";
-        // one input transaction contains only one transfer. e.g. <transaction_id> - <100XMR>
+    m_loading = true;
+    m_refreshPending = false;
+    m_scheduler.run([this] {
+        QElapsedTimer timer;
+        timer.start();
 
-        std::list<std::pair<crypto::hash, tools::wallet2::payment_details>> in_payments;
-        m_wallet2->get_payments(in_payments, min_height, max_height);
-        for (std::list<std::pair<crypto::hash, tools::wallet2::payment_details>>::const_iterator i = in_payments.begin(); i != in_payments.end(); ++i)
+        // The refresh thread writes the containers fetchRows() reads, hold the wallet while copying them
+        QList<TransactionRow> rows;
         {
-            const tools::wallet2::payment_details &pd = i->second;
-            if (pd.m_subaddr_index.major != account) {
-                continue;
+            while (!m_wallet->m_asyncMutex.tryLock(100)) {
+                if (m_scheduler.stopping()) {
+                    return;
+                }
             }
+            const auto unlock = sg::make_scope_guard([this]() noexcept {
+                m_wallet->m_asyncMutex.unlock();
+            });
+            rows = this->fetchRows();
+        }
 
-            std::string payment_id = epee::string_tools::pod_to_hex(i->first);
-            if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
-                payment_id = payment_id.substr(0,16);
-
-            TransactionRow t;
-            t.paymentId = QString::fromStdString(payment_id);
-            t.coinbase = pd.m_coinbase;
-            t.amount = pd.m_amount;
-            t.balanceDelta = pd.m_amount;
-            t.fee = pd.m_fee;
-            t.direction = TransactionRow::Direction_In;
-            t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(pd.m_tx_hash));
-            t.blockHeight = pd.m_block_height;
-            t.subaddrIndex = { pd.m_subaddr_index.minor };
-            t.subaddrAccount = pd.m_subaddr_index.major;
-            t.label = QString::fromStdString(m_wallet2->get_subaddress_label(pd.m_subaddr_index));
-            t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
-            t.confirmations = (wallet_height > pd.m_block_height) ? wallet_height - pd.m_block_height : 0;
-            t.unlockTime = pd.m_unlock_time;
-            t.description = description(m_wallet2, pd);
-
-            m_rows.append(std::move(t));
+        emit rowsLoaded(rows, timer.elapsed());
+    });
+}
+
+void TransactionHistory::ensureLoaded()
+{
+    if (m_loaded) {
+        return;
+    }
+
+    m_loaded = true;
+    this->refresh();
+}
+
+bool TransactionHistory::isLoaded() const
+{
+    return m_loaded;
+}
+
+void TransactionHistory::onRowsLoaded(const QList<TransactionRow> &rows, qint64 elapsed)
+{
+    m_loading = false;
+
+    // ensureLoaded() got there first
+    if (m_loaded) {
+        return;
+    }
+
+    qInfo() << "Transaction history loaded:" << rows.size() << "rows in" << elapsed << "ms";
+
+    emit refreshStarted();
+    {
+        QWriteLocker locker(&m_lock);
+        m_rows = rows;
+        m_locked = false;
+    }
+    m_loaded = true;
+    emit refreshFinished();
+
+    // The wallet changed while the rows were fetched
+    if (m_refreshPending) {
+        m_refreshPending = false;
+        this->refresh();
+    }
+}
+
+QList<TransactionRow> TransactionHistory::fetchRows() const
+{
+    QList<TransactionRow> rows;
+
+    uint64_t min_height = 0;
+    uint64_t max_height = (uint64_t)-1;
+    uint64_t wallet_height = m_wallet->blockChainHeight();
+    uint32_t account = m_wallet->currentSubaddressAccount();
+
+    StringPool strings;
+    QHash<quint32, QString> labels;
+    auto label = [&](quint32 minor) -> QString {
+        auto it = labels.constFind(minor);
+        if (it != labels.constEnd()) {
+            return *it;
         }
+        return labels.insert(minor, strings.intern(QString::fromStdString(m_wallet2->get_subaddress_label({account, minor})))).value();
+    };
 
-        // confirmed output transactions
-        // one output transaction may contain more than one money transfer, e.g.
-        // <transaction_id>:
-        //    transfer1: 100XMR to <address_1>
-        //    transfer2: 50XMR  to <address_2>
-        //    fee: fee charged per transaction
-        //
+    // transactions are stored in wallet2:
+    // - confirmed_transfer_details   - out transfers
+    // - unconfirmed_transfer_details - pending out transfers
+    // - payment_details              - input transfers
 
-        std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>> out_payments;
-        m_wallet2->get_payments_out(out_payments, min_height, max_height);
+    // payments are "input transactions";
+    // one input transaction contains only one transfer. e.g. <transaction_id> - <100XMR>
 
-        for (std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>>::const_iterator i = out_payments.begin();
-             i != out_payments.end(); ++i) {
+    std::list<std::pair<crypto::hash, tools::wallet2::payment_details>> in_payments;
+    m_wallet2->get_payments(in_payments, min_height, max_height);
+    for (std::list<std::pair<crypto::hash, tools::wallet2::payment_details>>::const_iterator i = in_payments.begin(); i != in_payments.end(); ++i)
+    {
+        const tools::wallet2::payment_details &pd = i->second;
+        if (pd.m_subaddr_index.major != account) {
+            continue;
+        }
 
-            const crypto::hash &hash = i->first;
-            const tools::wallet2::confirmed_transfer_details &pd = i->second;
-            if (pd.m_subaddr_account != account) {
-                continue;
-            }
+        TransactionRow t;
+        t.paymentId = strings.intern(paymentId(i->first));
+        t.coinbase = pd.m_coinbase;
+        t.amount = pd.m_amount;
+        t.balanceDelta = pd.m_amount;
+        t.fee = pd.m_fee;
+        t.direction = TransactionRow::Direction_In;
+        t.txid = rawHash(pd.m_tx_hash);
+        t.blockHeight = pd.m_block_height;
+        t.subaddrIndex.append(pd.m_subaddr_index.minor);
+        t.subaddrAccount = pd.m_subaddr_index.major;
+        t.label = label(pd.m_subaddr_index.minor);
+        t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
+        t.confirmations = (wallet_height > pd.m_block_height) ? wallet_height - pd.m_block_height : 0;
+        t.unlockTime = pd.m_unlock_time;
+        t.description = strings.intern(description(m_wallet2, pd, t.label));
+
+        rows.append(std::move(t));
+    }
 
-            uint64_t change = pd.m_change == (uint64_t)-1 ? 0 : pd.m_change; // change may not be known
-            // Bounds check to prevent unsigned underflow
-            uint64_t fee = (pd.m_amount_in >= pd.m_amount_out) ? (pd.m_amount_in - pd.m_amount_out) : 0;
-
-            std::string payment_id = epee::string_tools::pod_to_hex(i->second.m_payment_id);
-            if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
-                payment_id = payment_id.substr(0,16);
-
-            TransactionRow t;
-            t.paymentId = QString::fromStdString(payment_id);
-
-            t.amount = pd.m_amount_out - change;
-            t.balanceDelta = change - pd.m_amount_in;
-            t.fee = fee;
-
-            t.direction = TransactionRow::Direction_Out;
-            t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(hash));
-            t.blockHeight = pd.m_block_height;
-            t.description = QString::fromStdString(m_wallet2->get_tx_note(hash));
-            t.subaddrAccount = pd.m_subaddr_account;
-            t.label = QString::fromStdString(pd.m_subaddr_indices.size() == 1 ? m_wallet2->get_subaddress_label({pd.m_subaddr_account, *pd.m_subaddr_indices.begin()}) : "");
-            t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
-            t.confirmations = (wallet_height > pd.m_block_height) ? wallet_height - pd.m_block_height : 0;
-
-            for (uint32_t idx : t.subaddrIndex)
-            {
-                t.subaddrIndex.insert(idx);
-            }
+    // confirmed output transactions
+    // one output transaction may contain more than one money transfer, e.g.
+    // <transaction_id>:
+    //    transfer1: 100XMR to <address_1>
+    //    transfer2: 50XMR  to <address_2>
+    //    fee: fee charged per transaction
+    //
 
-            // single output transaction might contain multiple transfers
-            for (auto const &d: pd.m_dests)
-            {
-                t.transfers.emplace_back(
-                    d.amount,
-                    QString::fromStdString(d.address(m_wallet2->nettype(), pd.m_payment_id, !hasFakePaymentId)));
-            }
-            for (auto const &r: pd.m_rings)
-            {
-                t.rings.emplace_back(
-                    QString::fromStdString(epee::string_tools::pod_to_hex(r.first)),
-                    cryptonote::relative_output_offsets_to_absolute(r.second));
-            }
+    std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>> out_payments;
+    m_wallet2->get_payments_out(out_payments, min_height, max_height);
+
+    for (std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>>::const_iterator i = out_payments.begin();
+         i != out_payments.end(); ++i) {
+
+        const crypto::hash &hash = i->first;
+        const tools::wallet2::confirmed_transfer_details &pd = i->second;
+        if (pd.m_subaddr_account != account) {
+            continue;
+        }
+
+        uint64_t change = pd.m_change == (uint64_t)-1 ? 0 : pd.m_change; // change may not be known
+        // Bounds check to prevent unsigned underflow
+        uint64_t fee = (pd.m_amount_in >= pd.m_amount_out) ? (pd.m_amount_in - pd.m_amount_out) : 0;
+
+        TransactionRow t;
+        t.paymentId = strings.intern(paymentId(pd.m_payment_id));
+
+        t.amount = pd.m_amount_out - change;
+        t.balanceDelta = change - pd.m_amount_in;
+        t.fee = fee;
+
+        t.direction = TransactionRow::Direction_Out;
+        t.txid = rawHash(hash);
+        t.blockHeight = pd.m_block_height;
+        t.description = strings.intern(QString::fromStdString(m_wallet2->get_tx_note(hash)));
+        t.subaddrAccount = pd.m_subaddr_account;
+        t.label = pd.m_subaddr_indices.size() == 1 ? label(*pd.m_subaddr_indices.begin()) : QString();
+        t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
+        t.confirmations = (wallet_height > pd.m_block_height) ? wallet_height - pd.m_block_height : 0;
+        // subaddrIndex stays empty, it holds the receiving subaddresses that the proof dialog and search use
+
+        rows.append(std::move(t));
+    }
 
-            m_rows.append(std::move(t));
+    // unconfirmed output transactions
+    std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> upayments_out;
+    m_wallet2->get_unconfirmed_payments_out(upayments_out);
+    for (std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>>::const_iterator i = upayments_out.begin(); i != upayments_out.end(); ++i) {
+        const tools::wallet2::unconfirmed_transfer_details &pd = i->second;
+        if (pd.m_subaddr_account != account) {
+            continue;
+        }
+
+        const crypto::hash &hash = i->first;
+        uint64_t amount = pd.m_amount_in;
+        // Bounds check to prevent unsigned underflow
+        uint64_t fee = (amount >= pd.m_amount_out) ? (amount - pd.m_amount_out) : 0;
+        uint64_t change = pd.m_change == (uint64_t)-1 ? 0 : pd.m_change;
+        bool is_failed = pd.m_state == tools::wallet2::unconfirmed_transfer_details::failed;
+
+        TransactionRow t;
+        t.paymentId = strings.intern(paymentId(pd.m_payment_id));
+
+        t.amount = pd.m_amount_out - change;
+        t.balanceDelta = change - pd.m_amount_in;
+        t.fee = fee;
+
+        t.direction = TransactionRow::Direction_Out;
+        t.failed = is_failed;
+        t.pending = true;
+        t.txid = rawHash(hash);
+        t.description = strings.intern(QString::fromStdString(m_wallet2->get_tx_note(hash)));
+        t.subaddrAccount = pd.m_subaddr_account;
+        t.label = pd.m_subaddr_indices.size() == 1 ? label(*pd.m_subaddr_indices.begin()) : QString();
+        t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
+        t.confirmations = 0;
+
+        rows.append(std::move(t));
+    }
+
+
+    // unconfirmed payments (tx pool)
+    std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>> upayments;
+    m_wallet2->get_unconfirmed_payments(upayments);
+    for (std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>>::const_iterator i = upayments.begin(); i != upayments.end(); ++i) {
+        const tools::wallet2::payment_details &pd = i->second.m_pd;
+        if (pd.m_subaddr_index.major != account) {
+            continue;
         }
 
-        // unconfirmed output transactions
+        TransactionRow t;
+
+        t.paymentId = strings.intern(paymentId(i->first));
+        t.amount = pd.m_amount;
+        t.balanceDelta = pd.m_amount;
+        t.direction = TransactionRow::Direction_In;
+        t.txid = rawHash(pd.m_tx_hash);
+        t.blockHeight = pd.m_block_height;
+        t.pending = true;
+        t.subaddrIndex.append(pd.m_subaddr_index.minor);
+        t.subaddrAccount = pd.m_subaddr_index.major;
+        t.label = label(pd.m_subaddr_index.minor);
+        t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
+        t.confirmations = 0;
+        t.description = strings.intern(description(m_wallet2, pd, t.label));
+
+        rows.append(std::move(t));
+
+        LOG_PRINT_L1(__FUNCTION__ << ": Unconfirmed payment found " << pd.m_amount);
+    }
+
+    rows.squeeze();
+    return rows;
+}
+
+QList<Output> TransactionHistory::transfers(const TransactionRow &row) const
+{
+    QList<Output> transfers;
+    if (row.direction != TransactionRow::Direction_Out) {
+        return transfers;
+    }
+
+    const crypto::hash hash = toHash(row);
+    bool hasFakePaymentId = m_wallet->isTrezor();
+
+    auto addDestinations = [&](const std::vector<cryptonote::tx_destination_entry> &dests, const crypto::hash &payment_id) {
+        for (auto const &d: dests)
+        {
+            transfers.emplace_back(
+                d.amount,
+                QString::fromStdString(d.address(m_wallet2->nettype(), payment_id, !hasFakePaymentId)));
+        }
+    };
+
+    if (row.pending) {
         std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> upayments_out;
         m_wallet2->get_unconfirmed_payments_out(upayments_out);
-        for (std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>>::const_iterator i = upayments_out.begin(); i != upayments_out.end(); ++i) {
-            const tools::wallet2::unconfirmed_transfer_details &pd = i->second;
-            if (pd.m_subaddr_account != account) {
-                continue;
+        for (const auto &p : upayments_out) {
+            if (p.first == hash) {
+                addDestinations(p.second.m_dests, p.second.m_payment_id);
+                break;
             }
-
-            const crypto::hash &hash = i->first;
-            uint64_t amount = pd.m_amount_in;
-            // Bounds check to prevent unsigned underflow
-            uint64_t fee = (amount >= pd.m_amount_out) ? (amount - pd.m_amount_out) : 0;
-            uint64_t change = pd.m_change == (uint64_t)-1 ? 0 : pd.m_change;
-            std::string payment_id = epee::string_tools::pod_to_hex(i->second.m_payment_id);
-            if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
-                payment_id = payment_id.substr(0,16);
-            bool is_failed = pd.m_state == tools::wallet2::unconfirmed_transfer_details::failed;
-
-            TransactionRow t;
-            t.paymentId = QString::fromStdString(payment_id);
-
-            t.amount = pd.m_amount_out - change;
-            t.balanceDelta = change - pd.m_amount_in;
-            t.fee = fee;
-
-            t.direction = TransactionRow::Direction_Out;
-            t.failed = is_failed;
-            t.pending = true;
-            t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(hash));
-            t.description = QString::fromStdString(m_wallet2->get_tx_note(hash));
-            t.subaddrAccount = pd.m_subaddr_account;
-            t.label = QString::fromStdString(pd.m_subaddr_indices.size() == 1 ? m_wallet2->get_subaddress_label({pd.m_subaddr_account, *pd.m_subaddr_indices.begin()}) : "");
-            t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
-            t.confirmations = 0;
-            for (uint32_t idx : t.subaddrIndex)
-            {
-                t.subaddrIndex.insert(idx);
+        }
+    }
+    else {
+        // Only look at the block the transaction was mined in
+        std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>> out_payments;
+        m_wallet2->get_payments_out(out_payments, row.blockHeight > 0 ? row.blockHeight - 1 : 0, row.blockHeight);
+        for (const auto &p : out_payments) {
+            if (p.first == hash) {
+                addDestinations(p.second.m_dests, p.second.m_payment_id);
+                break;
             }
+        }
+    }
 
-            for (auto const &d: pd.m_dests)
-            {
-                t.transfers.emplace_back(
-                    d.amount,
-                    QString::fromStdString(d.address(m_wallet2->nettype(), pd.m_payment_id, !hasFakePaymentId)));
-            }
-            for (auto const &r: pd.m_rings)
-            {
-                t.rings.emplace_back(
-                    QString::fromStdString(epee::string_tools::pod_to_hex(r.first)),
-                    cryptonote::relative_output_offsets_to_absolute(r.second));
-            }
+    return transfers;
+}
 
-            m_rows.append(std::move(t));
-        }
+QList<Ring> TransactionHistory::rings(const TransactionRow &row) const
+{
+    if (row.direction != TransactionRow::Direction_Out) {
+        return {};
+    }
 
+    const crypto::hash hash = toHash(row);
 
-        // unconfirmed payments (tx pool)
-        std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>> upayments;
-        m_wallet2->get_unconfirmed_payments(upayments);
-        for (std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>>::const_iterator i = upayments.begin(); i != upayments.end(); ++i) {
-            const tools::wallet2::payment_details &pd = i->second.m_pd;
-            if (pd.m_subaddr_index.major != account) {
-                continue;
+    if (row.pending) {
+        std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> upayments_out;
+        m_wallet2->get_unconfirmed_payments_out(upayments_out);
+        for (const auto &p : upayments_out) {
+            if (p.first == hash) {
+                return ringsFromDetails(p.second);
+            }
+        }
+    }
+    else {
+        std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>> out_payments;
+        m_wallet2->get_payments_out(out_payments, row.blockHeight > 0 ? row.blockHeight - 1 : 0, row.blockHeight);
+        for (const auto &p : out_payments) {
+            if (p.first == hash) {
+                return ringsFromDetails(p.second);
             }
-
-            std::string payment_id = epee::string_tools::pod_to_hex(i->first);
-            if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
-                payment_id = payment_id.substr(0,16);
-
-            TransactionRow t;
-
-            t.paymentId = QString::fromStdString(payment_id);
-            t.amount = pd.m_amount;
-            t.balanceDelta = pd.m_amount;
-            t.direction = TransactionRow::Direction_In;
-            t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(pd.m_tx_hash));
-            t.blockHeight = pd.m_block_height;
-            t.pending = true;
-            t.subaddrIndex = { pd.m_subaddr_index.minor };
-            t.subaddrAccount = pd.m_subaddr_index.major;
-            t.label = QString::fromStdString(m_wallet2->get_subaddress_label(pd.m_subaddr_index));
-            t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
-            t.confirmations = 0;
-            t.description = description(m_wallet2, pd);
-
-            m_rows.append(std::move(t));
-
-            LOG_PRINT_L1(__FUNCTION__ << ": Unconfirmed payment found " << pd.m_amount);
         }
     }
 
-    emit refreshFinished();
+    return {};
 }
 
 quint64 TransactionHistory::count() const
@@ -298,33 +479,6 @@ bool TransactionHistory::locked() const
     return m_locked;
 }
 
-QStringList parseCSVLine(const QString &line) {
-    QStringList result;
-    QString currentField;
-    bool inQuotes = false;
-
-    for (int i = 0; i < line.length(); ++i) {
-        QChar currentChar = line[i];
-
-        if (currentChar == '"') {
-            if (inQuotes && i + 1 < line.length() && line[i + 1] == '"') {
-                currentField.append('"');
-                ++i;
-            } else {
-                inQuotes = !inQuotes;
-            }
-        } else if (currentChar == ',' && !inQuotes) {
-            result.append(currentField.trimmed());
-            currentField.clear();
-        } else {
-            currentField.append(currentChar);
-        }
-    }
-
-    result.append(currentField.trimmed());
-    return result;
-}
-
 QString TransactionHistory::importLabelsFromCSV(const QString &fileName) {
     QFile file(fileName);
 
@@ -337,7 +491,7 @@ QString TransactionHistory::importLabelsFromCSV(const QString &fileName) {
     QList<QStringList> fields;
     while (!in.atEnd()) {
         QString line = in.readLine();
-        fields.append(parseCSVLine(line));
+        fields.append(Utils::parseCSVLine(line));
     }
 
     if (fields.empty()) {
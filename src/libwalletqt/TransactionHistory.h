@@ -7,6 +7,7 @@
 #include <QReadWriteLock>
 
 #include "rows/TransactionRow.h"
+#include "utils/scheduler.h"
 
 namespace tools {
     class wallet2;
@@ -23,12 +24,22 @@ class TransactionHistory : public QObject
     Q_OBJECT
 
 public:
+    //! Does nothing until the rows are loaded
     void refresh();
+    //! Fills the rows on a worker thread, called when the history is first shown
+    void load();
+    //! Fills the rows right away, for callers that need them before the history was shown
+    void ensureLoaded();
+    bool isLoaded() const;
     quint64 count() const;
 
     const TransactionRow& transaction(int index);
     const QList<TransactionRow>& getRows();
 
+    //! Read from the wallet on demand, rows don't keep destinations and rings around
+    QList<Output> transfers(const TransactionRow &row) const;
+    QList<Ring> rings(const TransactionRow &row) const;
+
     void setTxNote(const QString &txid, const QString &note);
     bool locked() const;
 
@@ -41,9 +52,15 @@ signals:
     void lastDateTimeChanged() const;
     void txNoteChanged() const;
 
+    // Emitted from the worker thread, delivered to onRowsLoaded on the GUI thread
+    void rowsLoaded(const QList<TransactionRow> &rows, qint64 elapsed) const;
+
 private:
     explicit TransactionHistory(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent = nullptr);
 
+    QList<TransactionRow> fetchRows() const;
+    void onRowsLoaded(const QList<TransactionRow> &rows, qint64 elapsed);
+
 private:
     friend class Wallet;
     mutable QReadWriteLock m_lock;
@@ -59,6 +76,12 @@ private:
     mutable bool m_locked;
 
     quint32 lastAccountIndex = 0;
+
+    bool m_loaded = false;
+    bool m_loading = false;
+    bool m_refreshPending = false;
+
+    FutureScheduler m_scheduler;
 };
 
 #endif // FEATHER_TRANSACTIONHISTORY_H
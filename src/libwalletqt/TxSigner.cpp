@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "TxSigner.h"
+
+#include <QThread>
+#include <QThreadPool>
+
+#include "serialization/binary_utils.h"
+#include "wallet/wallet2.h"
+
+namespace {
+    // Must match SIGNED_TX_PREFIX in wallet2.cpp
+    const std::string SIGNED_TX_PREFIX = "Monero signed tx set\005";
+}
+
+TxSigner::TxSigner(tools::wallet2 *wallet2, QMutex *walletMutex, const std::string &unsignedTx, QObject *parent)
+        : QObject(parent)
+        , m_wallet2(wallet2)
+        , m_walletMutex(walletMutex)
+        , m_unsignedTx(unsignedTx)
+        , m_scheduler(this)
+{
+}
+
+TxSigner::~TxSigner() {
+    m_cancelled = true;
+    m_scheduler.shutdownWaitForFinished();
+}
+
+void TxSigner::start() {
+    m_cancelled = false;
+    m_scheduler.run([this] {
+        this->run();
+    });
+}
+
+void TxSigner::cancel() {
+    m_cancelled = true;
+}
+
+int TxSigner::txCount() const {
+    return m_txCount;
+}
+
+std::string TxSigner::signedTx() const {
+    QMutexLocker locker(&m_mutex);
+    return m_signedTx;
+}
+
+QString TxSigner::errorString() const {
+    QMutexLocker locker(&m_mutex);
+    return m_errorString;
+}
+
+void TxSigner::fail(const QString &error) {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_errorString = error;
+    }
+    emit finished(false);
+}
+
+void TxSigner::run() {
+    tools::wallet2::unsigned_tx_set exported;
+    try {
+        QMutexLocker locker(m_walletMutex);
+        if (m_wallet2->watch_only()) {
+            this->fail("This is a watch only wallet");
+            return;
+        }
+        if (!m_wallet2->parse_unsigned_tx_from_str(m_unsignedTx, exported)) {
+            this->fail("Failed to parse unsigned transaction set");
+            return;
+        }
+    }
+    catch (const std::exception &e) {
+        this->fail(QString("Failed to parse unsigned transaction set: %1").arg(e.what()));
+        return;
+    }
+
+    const int count = static_cast<int>(exported.txes.size());
+    if (count == 0) {
+        this->fail("Unsigned transaction set is empty");
+        return;
+    }
+
+    m_txCount = count;
+    emit parsed(count);
+
+    // Every transaction is signed as a set of its own, only the first one carries the outputs to import
+    std::vector<tools::wallet2::unsigned_tx_set> subsets(count);
+    for (int i = 0; i < count; i++) {
+        subsets[i].txes.push_back(exported.txes[i]);
+    }
+    subsets[0].transfers = exported.transfers;
+    subsets[0].new_transfers = exported.new_transfers;
+
+    std::vector<tools::wallet2::signed_tx_set> signedSets(count);
+    std::vector<QString> errors(count);
+    std::atomic<bool> failed = false;
+
+    auto signTx = [&](int i) {
+        if (m_cancelled || failed) {
+            return;
+        }
+
+        try {
+            std::vector<tools::wallet2::pending_tx> ptx;
+            if (!m_wallet2->sign_tx(subsets[i], ptx, signedSets[i]) || signedSets[i].ptx.empty()) {
+                errors[i] = QString("Failed to sign transaction %1").arg(i + 1);
+                failed = true;
+                return;
+            }
+        }
+        catch (const std::exception &e) {
+            errors[i] = QString("Failed to sign transaction %1: %2").arg(QString::number(i + 1), e.what());
+            failed = true;
+            return;
+        }
+
+        const crypto::hash txid = cryptonote::get_transaction_hash(signedSets[i].ptx[0].tx);
+        emit txSigned(i, QString::fromStdString(epee::string_tools::pod_to_hex(txid)));
+    };
+
+    // The wallet lock is held per transaction, or for the whole batch while the workers share wallet2
+    QMutexLocker locker(m_walletMutex);
+
+    // Importing outputs modifies the wallet, so the first transaction is always signed alone
+    signTx(0);
+
+    // sign_tx records tx keys in the wallet when store_tx_info is set, which is not safe to do concurrently.
+    // That is the default, so usually only wallets that don't store tx keys sign in parallel.
+    const bool parallel = !m_wallet2->store_tx_info() && m_wallet2->get_device_type() == hw::device::SOFTWARE;
+    if (parallel && count > 1) {
+        QVector<int> indices;
+        for (int i = 1; i < count; i++) {
+            indices.append(i);
+        }
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(QThread::idealThreadCount());
+        QtConcurrent::blockingMap(&pool, indices, [&signTx](int i) {
+            signTx(i);
+        });
+    }
+    else {
+        for (int i = 1; i < count; i++) {
+            locker.unlock();
+            locker.relock();
+            signTx(i);
+        }
+    }
+    locker.unlock();
+
+    if (failed) {
+        for (const auto &error : errors) {
+            if (!error.isEmpty()) {
+                this->fail(error);
+                return;
+            }
+        }
+    }
+
+    if (m_cancelled) {
+        emit finished(false);
+        return;
+    }
+
+    tools::wallet2::signed_tx_set merged;
+    for (auto &signedSet : signedSets) {
+        merged.ptx.insert(merged.ptx.end(), signedSet.ptx.begin(), signedSet.ptx.end());
+        merged.tx_key_images.insert(signedSet.tx_key_images.begin(), signedSet.tx_key_images.end());
+    }
+
+    // Every set holds the key images of all outputs known to the wallet after the import
+    merged.key_images = signedSets[0].key_images;
+
+    std::string blob;
+    try {
+        if (!::serialization::dump_binary(merged, blob)) {
+            this->fail("Failed to serialize signed transaction set");
+            return;
+        }
+    }
+    catch (const std::exception &e) {
+        this->fail(QString("Failed to serialize signed transaction set: %1").arg(e.what()));
+        return;
+    }
+
+    std::string signedTx;
+    {
+        QMutexLocker walletLocker(m_walletMutex);
+        signedTx = SIGNED_TX_PREFIX + m_wallet2->encrypt_with_view_secret_key(blob);
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_signedTx = signedTx;
+    }
+
+    emit finished(true);
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_TXSIGNER_H
+#define FEATHER_TXSIGNER_H
+
+#include <QObject>
+#include <QMutex>
+
+#include <atomic>
+
+#include "utils/scheduler.h"
+
+namespace tools {
+    class wallet2;
+}
+
+// Signs an unsigned transaction set off the GUI thread, one transaction at a time, and assembles the signed set.
+// Progress is reported per transaction and the job can be cancelled between transactions.
+class TxSigner : public QObject
+{
+Q_OBJECT
+
+public:
+    ~TxSigner() override;
+
+    void start();
+    void cancel();
+
+    //! Number of transactions in the set, known once parsed() was emitted
+    int txCount() const;
+
+    //! The signed transaction set, valid after finished(true)
+    std::string signedTx() const;
+    QString errorString() const;
+
+signals:
+    void parsed(int txCount);
+    void txSigned(int index, const QString &txid);
+    void finished(bool success);
+
+private:
+    explicit TxSigner(tools::wallet2 *wallet2, QMutex *walletMutex, const std::string &unsignedTx, QObject *parent = nullptr);
+    friend class Wallet;
+
+    void run();
+    void fail(const QString &error);
+
+    tools::wallet2 *m_wallet2;
+    QMutex *m_walletMutex; // Wallet::m_asyncMutex, held whenever wallet2 is used
+    std::string m_unsignedTx;
+
+    mutable QMutex m_mutex;
+    std::string m_signedTx;
+    QString m_errorString;
+
+    std::atomic<int> m_txCount = 0;
+    std::atomic<bool> m_cancelled = false;
+    FutureScheduler m_scheduler;
+};
+
+#endif //FEATHER_TXSIGNER_H
@@ -3,14 +3,25 @@
 
 #include "Wallet.h"
 
+#include <QElapsedTimer>
+
 #include <chrono>
+#include <numeric>
 #include <thread>
 
 #include "AddressBook.h"
+#include "BalanceCache.h"
+#include "BlockHashCache.h"
 #include "Coins.h"
+#include "CoinSelector.h"
+#include "ConsolidationPlanner.h"
+#include "FeeEstimator.h"
 #include "Subaddress.h"
 #include "SubaddressAccount.h"
+#include "SyncMetrics.h"
+#include "SyncScheduler.h"
 #include "TransactionHistory.h"
+#include "TxSigner.h"
 #include "WalletManager.h"
 #include "WalletListenerImpl.h"
 
@@ -45,13 +56,16 @@ Wallet::Wallet(Monero::Wallet *wallet, QObject *parent)
         , m_connectionStatus(Wallet::ConnectionStatus_Disconnected)
         , m_currentSubaddressAccount(0)
         , m_subaddress(new Subaddress(this, wallet->getWallet(), this))
-        , m_subaddressAccount(new SubaddressAccount(wallet->getWallet(), this))
+        , m_balanceCache(new BalanceCache(wallet->getWallet(), this))
+        , m_subaddressAccount(new SubaddressAccount(wallet->getWallet(), m_balanceCache, this))
         , m_refreshNow(false)
         , m_refreshEnabled(false)
         , m_scheduler(this)
         , m_useSSL(true)
         , m_coins(new Coins(this, wallet->getWallet(), this))
         , m_storeTimer(new QTimer(this))
+        , m_feeEstimator(new FeeEstimator(this, this))
+        , m_syncMetrics(new SyncMetrics(this, this))
 {
     m_walletListener = new WalletListenerImpl(this);
     m_walletImpl->setListener(m_walletListener);
@@ -62,6 +76,8 @@ Wallet::Wallet(Monero::Wallet *wallet, QObject *parent)
     m_subaddressAccountModel = new SubaddressAccountModel(this, m_subaddressAccount);
     m_coinsModel = new CoinsModel(this, m_coins);
 
+    syncScheduler()->registerWallet(this, this->walletName());
+
     if (this->status() == Status_Ok) {
         startRefreshThread();
 
@@ -79,6 +95,7 @@ Wallet::Wallet(Monero::Wallet *wallet, QObject *parent)
     connect(this, &Wallet::updated, this, &Wallet::onUpdated);
     connect(this, &Wallet::heightsRefreshed, this, &Wallet::onHeightsRefreshed);
     connect(this, &Wallet::transactionCommitted, this, &Wallet::onTransactionCommitted);
+    connect(this, &Wallet::moneySpent, m_balanceCache, &BalanceCache::onMoneySpent);
 
     connect(m_subaddress, &Subaddress::corrupted, [this]{
        emit keysCorrupted();
@@ -140,14 +157,11 @@ quint64 Wallet::balance() const {
 }
 
 quint64 Wallet::balance(quint32 accountIndex) const {
-    return m_wallet2->balance(accountIndex, false);
+    return m_balanceCache->account(accountIndex).balance;
 }
 
 quint64 Wallet::balanceAll() const {
-    uint64_t result = 0;
-    for (uint32_t i = 0; i < numSubaddressAccounts(); ++i)
-        result += balance(i);
-    return result;
+    return m_balanceCache->total().balance;
 }
 
 quint64 Wallet::unlockedBalance() const {
@@ -155,14 +169,11 @@ quint64 Wallet::unlockedBalance() const {
 }
 
 quint64 Wallet::unlockedBalance(quint32 accountIndex) const {
-    return m_wallet2->unlocked_balance(accountIndex, false);
+    return m_balanceCache->account(accountIndex).unlocked;
 }
 
 quint64 Wallet::unlockedBalanceAll() const {
-    uint64_t result = 0;
-    for (uint32_t i = 0; i < numSubaddressAccounts(); ++i)
-        result += unlockedBalance(i);
-    return result;
+    return m_balanceCache->total().unlocked;
 }
 
 quint64 Wallet::viewOnlyBalance(quint32 accountIndex) const {
@@ -412,12 +423,19 @@ void Wallet::initAsync(const QString &daemonAddress, bool trustedDaemon, quint64
         bool success;
         {
             QMutexLocker locker(&m_proxyMutex);
+            m_daemonAddress = daemonAddress;
             success = m_walletImpl->init(daemonAddress.toStdString(), upperTransactionLimit, m_daemonUsername.toStdString(), m_daemonPassword.toStdString(), m_useSSL, false, proxyAddress.toStdString());
         }
 
         setTrustedDaemon(trustedDaemon);
 
         if (success) {
+            {
+                // Skip downloading block hashes another wallet already fetched
+                QMutexLocker locker(&m_asyncMutex);
+                BlockHashCache::instance()->seed(m_wallet2, daemonAddress);
+            }
+
             qDebug() << "init async finished - starting refresh";
             startRefresh();
         }
@@ -440,6 +458,14 @@ void Wallet::pauseRefresh() {
     m_refreshEnabled = false;
 }
 
+void Wallet::beginClose() {
+    m_closing = true;
+    pauseRefresh();
+
+    // Interrupts a refresh in progress at the next block
+    m_walletImpl->stop();
+}
+
 void Wallet::startRefreshThread()
 {
     const auto future = m_scheduler.run([this] {
@@ -449,7 +475,7 @@ void Wallet::startRefreshThread()
         constexpr const std::chrono::milliseconds intervalResolution{100};
 
         auto last = std::chrono::steady_clock::now();
-        while (!m_scheduler.stopping())
+        while (!m_scheduler.stopping() && !m_closing)
         {
             if (m_refreshEnabled && (!isHwBacked() || isDeviceConnected()))
             {
@@ -457,17 +483,33 @@ void Wallet::startRefreshThread()
                 const auto elapsed = now - last;
                 if (elapsed >= refreshInterval || m_refreshNow)
                 {
+                    // Wait for a refresh slot, other open wallets may be syncing. The timeout lets us notice a shutdown.
+                    if (!syncScheduler()->acquire(this, 500)) {
+                        continue;
+                    }
+                    const auto release = sg::make_scope_guard([this]() noexcept {
+                        syncScheduler()->release(this);
+                    });
+
                     m_refreshNow = false;
 
+                    QString daemonAddress;
+                    {
+                        QMutexLocker locker(&m_proxyMutex);
+                        daemonAddress = m_daemonAddress;
+                    }
+
                     // get daemonHeight and targetHeight
                     // daemonHeight and targetHeight will be 0 if call to get_info fails
-                    quint64 daemonHeight = m_walletImpl->daemonBlockChainHeight();
-                    bool success = daemonHeight > 0;
-
-                    quint64 targetHeight = 0;
-                    if (success) {
-                        targetHeight = m_walletImpl->daemonBlockChainTargetHeight();
-                    }
+                    // wallets connected to the same node share the result of a recent poll
+                    auto [daemonHeight, targetHeight] = syncScheduler()->daemonHeights(this, daemonAddress, [this]() -> QPair<quint64, quint64> {
+                        quint64 daemonHeight = m_walletImpl->daemonBlockChainHeight();
+                        quint64 targetHeight = 0;
+                        if (daemonHeight > 0) {
+                            targetHeight = m_walletImpl->daemonBlockChainTargetHeight();
+                        }
+                        return {daemonHeight, targetHeight};
+                    });
                     bool haveHeights = (daemonHeight > 0 && targetHeight > 0);
 
                     emit heightsRefreshed(haveHeights, daemonHeight, targetHeight);
@@ -477,13 +519,20 @@ void Wallet::startRefreshThread()
                     if (haveHeights) {
                         QMutexLocker locker(&m_asyncMutex);
 
+                        // The wallet started closing while we waited, don't start a refresh that would have to be interrupted
+                        if (m_closing) {
+                            break;
+                        }
+
                         if (m_newWallet) {
                             // Set blockheight to daemonHeight for newly created wallets to speed up initial sync
                             m_walletImpl->setRefreshFromBlockHeight(daemonHeight);
                             m_newWallet = false;
                         }
 
+                        m_syncMetrics->refreshStarted();
                         m_walletImpl->refresh();
+                        m_syncMetrics->refreshFinished();
                     }
                     last = std::chrono::steady_clock::now();
                 }
@@ -541,6 +590,8 @@ void Wallet::syncStatusUpdated(quint64 height, quint64 target) {
         this->updateBalance();
     }
 
+    syncScheduler()->reportHeight(this, height, target);
+
     emit syncStatus(height, target, false);
 }
 
@@ -548,6 +599,14 @@ void Wallet::onNewBlock(uint64_t walletHeight) {
     // Called whenever a new block gets scanned by the wallet
     quint64 daemonHeight = m_daemonBlockChainTargetHeight;
 
+    // Blocks are scanned in order, scanning one again means blocks were detached (reorg or rescan). Detaching marks
+    // outputs spent in those blocks as unspent, which the balance cache cannot tell from the height alone once the
+    // wallet has caught up again.
+    if (walletHeight <= m_lastScannedBlock) {
+        m_balanceCache->invalidate();
+    }
+    m_lastScannedBlock = walletHeight;
+
     if (walletHeight < (daemonHeight - 1)) {
         setConnectionStatus(ConnectionStatus_Synchronizing);
     } else {
@@ -557,18 +616,24 @@ void Wallet::onNewBlock(uint64_t walletHeight) {
     this->syncStatusUpdated(walletHeight, daemonHeight);
 
     if (this->isSynchronized()) {
+        QElapsedTimer timer;
+        timer.start();
         m_history->refresh();
         m_coins->refresh();
         this->subaddress()->updateUsed(this->currentSubaddressAccount());
+        m_syncMetrics->addModelTime(timer.elapsed());
     }
 }
 
 void Wallet::onUpdated() {
     this->updateBalance();
     if (this->isSynchronized()) {
+        QElapsedTimer timer;
+        timer.start();
         m_history->refresh();
         m_coins->refresh();
         this->subaddress()->updateUsed(this->currentSubaddressAccount());
+        m_syncMetrics->addModelTime(timer.elapsed());
     }
 }
 
@@ -589,9 +654,12 @@ void Wallet::onRefreshed(bool success, const QString &message) {
 }
 
 void Wallet::refreshModels() {
+    QElapsedTimer timer;
+    timer.start();
     m_history->refresh();
     m_coins->refresh();
     m_subaddress->refresh();
+    m_syncMetrics->addModelTime(timer.elapsed());
 }
 
 // #################### Hardware wallet ####################
@@ -667,12 +735,16 @@ bool Wallet::exportKeyImagesForOutputsFromStr(const std::string &outputs, std::s
 
 bool Wallet::importKeyImages(const QString& path) {
     bool r = m_walletImpl->importKeyImages(path.toStdString());
+    m_balanceCache->invalidate();
+    this->updateBalance();
     this->coins()->refresh();
     return r;
 }
 
 bool Wallet::importKeyImagesFromStr(const std::string &keyImages) {
     bool r = m_walletImpl->importKeyImagesFromStr(keyImages);
+    m_balanceCache->invalidate();
+    this->updateBalance();
     this->coins()->refresh();
     return r;
 }
@@ -686,16 +758,71 @@ bool Wallet::exportOutputsToStr(std::string& outputs, bool all) {
 }
 
 bool Wallet::importOutputs(const QString& path) {
-    return m_walletImpl->importOutputs(path.toStdString());
+    bool r = m_walletImpl->importOutputs(path.toStdString());
+    m_balanceCache->invalidate();
+    return r;
 }
 
 bool Wallet::importOutputsFromStr(const std::string &outputs) {
-    return m_walletImpl->importOutputsFromStr(outputs);
+    bool r = m_walletImpl->importOutputsFromStr(outputs);
+    m_balanceCache->invalidate();
+    return r;
 }
 
 bool Wallet::importTransaction(const QString& txid) {
     std::vector<std::string> txids = {txid.toStdString()};
-    return m_walletImpl->scanTransactions(txids);
+    bool r = m_walletImpl->scanTransactions(txids);
+    m_balanceCache->invalidate();
+    return r;
+}
+
+bool Wallet::importTransactions(const QStringList& txids) {
+    std::vector<std::string> ids;
+    for (const auto &txid : txids) {
+        ids.push_back(txid.toStdString());
+    }
+
+    // scan_tx writes the transfer and payment containers, as does the refresh thread
+    QMutexLocker locker(&m_asyncMutex);
+    bool r = m_walletImpl->scanTransactions(ids);
+    m_balanceCache->invalidate();
+    return r;
+}
+
+bool Wallet::lookupTransactions(const QStringList &txids, QHash<QString, quint64> &found, QString &error) {
+    cryptonote::COMMAND_RPC_GET_TRANSACTIONS::request req;
+    cryptonote::COMMAND_RPC_GET_TRANSACTIONS::response res;
+    for (const auto &txid : txids) {
+        req.txs_hashes.push_back(txid.toStdString());
+    }
+    req.decode_as_json = false;
+    req.prune = true;
+
+    // Same daemon, scheme, login and proxy as the refresh
+    try {
+        if (!m_wallet2->invoke_http_json("/gettransactions", req, res)) {
+            error = "No response from node";
+            return false;
+        }
+    }
+    catch (const std::exception &e) {
+        error = e.what();
+        return false;
+    }
+
+    if (res.status != CORE_RPC_STATUS_OK) {
+        error = QString::fromStdString(res.status);
+        return false;
+    }
+
+    for (const auto &tx : res.txs) {
+        QString txid = QString::fromStdString(tx.tx_hash);
+        if (!txids.contains(txid)) {
+            continue;
+        }
+        found[txid] = tx.in_pool ? std::numeric_limits<quint64>::max() : tx.block_height;
+    }
+    return true;
 }
 
 // #################### Wallet cache ####################
@@ -711,9 +838,39 @@ void Wallet::storeSafer() {
     }
 
     qDebug() << "Storing wallet";
+    this->contributeBlockHashes();
     this->store();
 }
 
+void Wallet::contributeBlockHashes() {
+    // Roughly once per day of blocks is enough to keep the shared cache current
+    quint64 height = this->blockChainHeight();
+    if (height < m_blockHashesContributedHeight + 720) {
+        return;
+    }
+    m_blockHashesContributedHeight = height;
+
+    // Export before store() trims the hash chain: the cache can only be started from a chain that still reaches
+    // back to genesis, which is only the case after a restore, before the wallet was first stored.
+    int nettype;
+    std::tuple<size_t, crypto::hash, std::vector<crypto::hash>> blockchain;
+    {
+        QMutexLocker locker(&m_asyncMutex);
+        nettype = static_cast<int>(m_wallet2->nettype());
+        blockchain = m_wallet2->export_blockchain();
+    }
+
+    QString daemonAddress;
+    {
+        QMutexLocker locker(&m_proxyMutex);
+        daemonAddress = m_daemonAddress;
+    }
+
+    m_scheduler.run([nettype, daemonAddress, blockchain = std::move(blockchain)] {
+        BlockHashCache::instance()->contribute(nettype, daemonAddress, blockchain);
+    });
+}
+
 QString Wallet::cachePath() const {
     return QDir::toNativeSeparators(QString::fromStdString(m_wallet2->get_wallet_file()));
 }
@@ -862,16 +1019,35 @@ void Wallet::preTransactionChecks(int feeLevel) {
 void Wallet::automaticFeeAdjustment(int feeLevel) {
   m_scheduler.run([this, feeLevel]{
       QVector<quint64> results;
-
-      std::vector<std::pair<uint64_t, uint64_t>> blocks;
       uint64_t priority = 0;
-      try {
-        priority = m_wallet2->adjust_priority(0, blocks);
+
+      if (!m_feeEstimator->isFresh()) {
+          try {
+              this->refreshTxPoolStats();
+          }
+          catch (const std::exception &e) {
+              qWarning() << "Failed to refresh fee estimate: " << QString::fromStdString(e.what());
+          }
       }
-      catch (const std::exception &e) { }
 
-      for (const auto &block : blocks) {
-        results.append(block.first);
+      if (m_feeEstimator->isFresh()) {
+          FeeEstimate estimate = m_feeEstimator->current();
+          for (const auto &tier : estimate.tiers) {
+              results.append(tier.blocks);
+          }
+          priority = m_feeEstimator->automaticFeeLevel();
+      }
+      else {
+          // Fall back to wallet2's own estimate
+          std::vector<std::pair<uint64_t, uint64_t>> blocks;
+          try {
+            priority = m_wallet2->adjust_priority(0, blocks);
+          }
+          catch (const std::exception &e) { }
+
+          for (const auto &block : blocks) {
+            results.append(block.first);
+          }
       }
 
       emit txPoolBacklog(results, feeLevel, priority);
@@ -893,14 +1069,22 @@ void Wallet::createTransaction(const QString &address, quint64 amount, const QSt
 
     qInfo() << "Creating transaction";
     m_scheduler.run([this, all, address, amount, feeLevel, subtractFeeFromAmount] {
-        std::set<uint32_t> subaddr_indices;
+        auto create = [this, all, address, amount, feeLevel, subtractFeeFromAmount](const std::set<std::string> &inputs) {
+            std::set<uint32_t> subaddr_indices;
+            return m_walletImpl->createTransaction(address.toStdString(), "", all ? std::optional<uint64_t>() : std::optional<uint64_t>(amount), constants::mixin,
+                                                   static_cast<Monero::PendingTransaction::Priority>(feeLevel),
+                                                   currentSubaddressAccount(), subaddr_indices, inputs, subtractFeeFromAmount);
+        };
+
+        CoinSelection selection;
+        if (m_selectedInputs.empty() && !all && conf()->get(Config::minimizeFeeInputSelection).toBool()) {
+            selection = this->selectInputs(amount, 1, feeLevel, subtractFeeFromAmount);
+        }
 
-        Monero::PendingTransaction *ptImpl = m_walletImpl->createTransaction(address.toStdString(), "", all ? std::optional<uint64_t>() : std::optional<uint64_t>(amount), constants::mixin,
-                                                                             static_cast<Monero::PendingTransaction::Priority>(feeLevel),
-                                                                             currentSubaddressAccount(), subaddr_indices, m_selectedInputs, subtractFeeFromAmount);
+        Monero::PendingTransaction *ptImpl = this->createWithSelection(create, selection);
 
         QVector<QString> addresses{address};
-        this->onTransactionCreated(ptImpl, addresses);
+        this->onTransactionCreated(ptImpl, addresses, selection);
     });
 }
 
@@ -919,12 +1103,22 @@ void Wallet::createTransactionMultiDest(const QVector<QString> &addresses, const
             amount.push_back(a);
         }
 
-        std::set<uint32_t> subaddr_indices;
-        Monero::PendingTransaction *ptImpl = m_walletImpl->createTransactionMultDest(dests, "", amount, constants::mixin,
-                                                                                     static_cast<Monero::PendingTransaction::Priority>(feeLevel),
-                                                                                     currentSubaddressAccount(), subaddr_indices, m_selectedInputs, subtractFeeFromAmount);
+        auto create = [this, dests, amount, feeLevel, subtractFeeFromAmount](const std::set<std::string> &inputs) {
+            std::set<uint32_t> subaddr_indices;
+            return m_walletImpl->createTransactionMultDest(dests, "", amount, constants::mixin,
+                                                           static_cast<Monero::PendingTransaction::Priority>(feeLevel),
+                                                           currentSubaddressAccount(), subaddr_indices, inputs, subtractFeeFromAmount);
+        };
+
+        CoinSelection selection;
+        if (m_selectedInputs.empty() && conf()->get(Config::minimizeFeeInputSelection).toBool()) {
+            quint64 total = std::accumulate(amount.begin(), amount.end(), quint64(0));
+            selection = this->selectInputs(total, static_cast<int>(amount.size()), feeLevel, subtractFeeFromAmount);
+        }
 
-        this->onTransactionCreated(ptImpl, addresses);
+        Monero::PendingTransaction *ptImpl = this->createWithSelection(create, selection);
+
+        this->onTransactionCreated(ptImpl, addresses, selection);
     });
 }
 
@@ -949,13 +1143,125 @@ void Wallet::sweepOutputs(const QVector<QString> &keyImages, QString address, bo
     });
 }
 
+void Wallet::planConsolidation(int maxInputs, bool mergeSubaddresses, int feeLevel) {
+    m_scheduler.run([this, maxInputs, mergeSubaddresses, feeLevel] {
+        ConsolidationPlan plan;
+
+        // Every batch is swept to a single destination, wallet2 adds a change output
+        CoinSelector::FeeFunction fee = this->feeFunction(feeLevel, 2);
+        if (fee) {
+            plan = ConsolidationPlanner::plan(this->spendableCandidates(), maxInputs, mergeSubaddresses, fee);
+        }
+
+        emit consolidationPlanned(plan);
+    });
+}
+
+CoinSelector::FeeFunction Wallet::feeFunction(int feeLevel, int numOutputs) {
+    // Beware! This code does not run in the GUI thread.
+
+    std::vector<uint64_t> baseFees;
+    uint64_t quantizationMask = 1;
+    uint64_t mixin = 0;
+    try {
+        baseFees = m_wallet2->get_base_fees();
+        quantizationMask = m_wallet2->get_fee_quantization_mask();
+        mixin = m_wallet2->get_min_ring_size() - 1;
+    }
+    catch (const std::exception &e) {
+        qWarning() << "Failed to get fee parameters: " << QString::fromStdString(e.what());
+        return {};
+    }
+
+    if (baseFees.size() != 4) {
+        return {};
+    }
+
+    // wallet2 picks Low or Normal for the automatic fee level, see FeeEstimator::automaticFeeLevel
+    int priority = feeLevel > 0 ? feeLevel : std::max(1, m_feeEstimator->automaticFeeLevel());
+    priority = std::min(priority, 4);
+
+    const uint64_t baseFee = baseFees[priority - 1];
+    numOutputs = std::max(2, numOutputs);
+    return [mixin, numOutputs, baseFee, quantizationMask](int numInputs) -> quint64 {
+        // Tx public key, encrypted payment id and an additional public key per output for subaddress destinations
+        const size_t extraSize = 33 + 11 + 33 * numOutputs;
+        return tools::wallet2::estimate_fee(true, true, numInputs, mixin, numOutputs, extraSize, true, true, true, true, baseFee, quantizationMask);
+    };
+}
+
+QVector<CoinCandidate> Wallet::spendableCandidates() {
+    // Beware! This code does not run in the GUI thread.
+
+    QVector<CoinCandidate> candidates;
+
+    boost::shared_lock<boost::shared_mutex> transfers_lock(m_wallet2->m_transfers_mutex);
+
+    const quint32 account = currentSubaddressAccount();
+    for (size_t i = 0; i < m_wallet2->get_num_transfer_details(); ++i) {
+        const tools::wallet2::transfer_details &td = m_wallet2->get_transfer_details(i);
+
+        if (td.m_subaddr_index.major != account || !td.m_rct || td.m_frozen || !td.m_key_image_known
+            || m_wallet2->is_spent(td, false) || !m_wallet2->is_transfer_unlocked(td)) {
+            continue;
+        }
+
+        CoinCandidate candidate;
+        candidate.amount = td.amount();
+        candidate.subaddrIndex = td.m_subaddr_index.minor;
+        candidate.blockHeight = td.m_block_height;
+        candidate.keyImage = QString::fromStdString(epee::string_tools::pod_to_hex(td.m_key_image));
+        candidates.append(candidate);
+    }
+
+    return candidates;
+}
+
+CoinSelection Wallet::selectInputs(quint64 amount, int numDestinations, int feeLevel, bool subtractFeeFromAmount) {
+    // Beware! This code does not run in the GUI thread.
+
+    CoinSelector::FeeFunction fee = this->feeFunction(feeLevel, numDestinations + 1); // Destinations and change
+    if (!fee) {
+        return {};
+    }
+
+    return CoinSelector::select(this->spendableCandidates(), amount, subtractFeeFromAmount, fee);
+}
+
+Monero::PendingTransaction* Wallet::createWithSelection(const TransactionFactory &create, CoinSelection &selection) {
+    // Beware! This code does not run in the GUI thread.
+
+    if (!selection.isValid()) {
+        return create(m_selectedInputs);
+    }
+
+    std::set<std::string> inputs;
+    for (const auto &keyImage : selection.keyImages) {
+        inputs.insert(keyImage.toStdString());
+    }
+
+    Monero::PendingTransaction *ptImpl = create(inputs);
+    if (ptImpl->status() == Monero::PendingTransaction::Status_Ok) {
+        qInfo() << "Coin selection: using" << selection.keyImages.size() << "inputs instead of" << selection.defaultInputs
+                << "- estimated fee saving:" << WalletManager::displayAmount(selection.saving());
+        return ptImpl;
+    }
+
+    // The fee estimate was too low for the selected inputs, leave the choice to wallet2
+    qWarning() << "Coin selection: selected inputs were rejected, falling back to the default picker: " << QString::fromStdString(ptImpl->errorString());
+    m_walletImpl->disposeTransaction(ptImpl);
+    selection = {};
+    return create(m_selectedInputs);
+}
+
 // Phase 2: Transaction construction completed
 
-void Wallet::onTransactionCreated(Monero::PendingTransaction *mtx, const QVector<QString> &address) {
+void Wallet::onTransactionCreated(Monero::PendingTransaction *mtx, const QVector<QString> &address, const CoinSelection &selection) {
     qDebug() << Q_FUNC_INFO;
     startRefresh();
 
     PendingTransaction *tx = new PendingTransaction(mtx, this);
+    tx->m_coinSelection = selection;
 
     // tx created, but not sent yet. ask user to verify first.
     emit transactionCreated(tx, address);
@@ -1047,6 +1353,10 @@ UnsignedTransaction * Wallet::loadTxFromBase64Str(const QString &unsigned_tx)
     return result;
 }
 
+TxSigner * Wallet::createTxSigner(const std::string &unsignedTx) {
+    return new TxSigner(m_wallet2, &m_asyncMutex, unsignedTx);
+}
+
 PendingTransaction * Wallet::loadSignedTxFile(const QString &fileName)
 {
     qDebug() << "Tying to load " << fileName;
@@ -1068,7 +1378,9 @@ bool Wallet::submitTxFile(const QString &fileName) const
     if (!m_walletImpl->submitTransaction(fileName.toStdString()))
         return false;
     // import key images
-    return m_walletImpl->importKeyImages(fileName.toStdString() + "_keyImages");
+    bool r = m_walletImpl->importKeyImages(fileName.toStdString() + "_keyImages");
+    m_balanceCache->invalidate();
+    return r;
 }
 
 bool Wallet::removeFailedTx(const QString &txid)
@@ -1142,6 +1454,18 @@ CoinsModel* Wallet::coinsModel() const {
     return m_coinsModel;
 }
 
+FeeEstimator* Wallet::feeEstimator() const {
+    return m_feeEstimator;
+}
+
+SyncMetrics* Wallet::syncMetrics() const {
+    return m_syncMetrics;
+}
+
+BalanceCache* Wallet::balanceCache() const {
+    return m_balanceCache;
+}
+
 // #################### Transaction proofs ####################
 
 QString Wallet::getTxKey(const QString &txid) const {
@@ -1206,6 +1530,10 @@ void Wallet::checkSpendProofAsync(const QString &txid, const QString &message, c
     });
 }
 
+ProofBatch * Wallet::createProofBatch(ProofBatch::Mode mode, const QList<ProofBatchEntry> &entries) {
+    return new ProofBatch(m_wallet2, mode, entries);
+}
+
 // #################### Sign / Verify message ####################
 
 QString Wallet::signMessage(const QString &message, bool filename, const QString &address) const {
@@ -1370,6 +1698,8 @@ bool Wallet::rescanSpent() {
     QMutexLocker locker(&m_asyncMutex);
 
     bool r = m_walletImpl->rescanSpent();
+    m_balanceCache->invalidate();
+    this->updateBalance();
     m_coins->refresh();
     return r;
 }
@@ -1432,34 +1762,55 @@ bool Wallet::getBlockWeightLimit(quint64 &blockWeightLimit) {
 
 void Wallet::getTxPoolStatsAsync() {
     m_scheduler.run([this] {
-        QVector<TxBacklogEntry> txPoolBacklog;
+        this->refreshTxPoolStats();
+    });
+}
 
-        quint64 blockWeightLimit = m_wallet2->get_block_weight_limit();
-        std::vector<uint64_t> base_fees = m_wallet2->get_base_fees();
+void Wallet::refreshTxPoolStats() {
+    // Beware! This code does not run in the GUI thread.
 
-        QVector<quint64> baseFees;
-        for (const auto &fee : base_fees) {
-            baseFees.push_back(fee);
-        }
+    QVector<TxBacklogEntry> txPoolBacklog;
 
-        auto entries = m_wallet2->get_txpool_backlog();
-        for (const auto &entry : entries) {
-            TxBacklogEntry result{entry.weight, entry.fee, entry.time_in_pool};
-            txPoolBacklog.push_back(result);
-        }
+    quint64 blockWeightLimit = m_wallet2->get_block_weight_limit();
+    std::vector<uint64_t> base_fees = m_wallet2->get_base_fees();
 
-        emit poolStats(txPoolBacklog, baseFees, blockWeightLimit);
-    });
+    QVector<quint64> baseFees;
+    for (const auto &fee : base_fees) {
+        baseFees.push_back(fee);
+    }
+
+    auto entries = m_wallet2->get_txpool_backlog();
+    txPoolBacklog.reserve(entries.size());
+    for (const auto &entry : entries) {
+        TxBacklogEntry result{entry.weight, entry.fee, entry.time_in_pool};
+        txPoolBacklog.push_back(result);
+    }
+
+    m_feeEstimator->update(txPoolBacklog, baseFees, blockWeightLimit);
+
+    emit poolStats(txPoolBacklog, baseFees, blockWeightLimit);
 }
 
 Wallet::~Wallet()
 {
     qDebug() << "~Wallet: Closing wallet" << QThread::currentThreadId();
 
+    m_closing = true;
     pauseRefresh();
+
+    // stop() only interrupts a refresh that already started, keep calling it until the refresh thread lets go of the
+    // wallet. It checks m_closing before it starts the next refresh.
+    while (!m_asyncMutex.tryLock(100)) {
+        m_walletImpl->stop();
+    }
+    m_asyncMutex.unlock();
     m_walletImpl->stop();
 
     m_scheduler.shutdownWaitForFinished();
+    m_subaddress->m_scheduler.shutdownWaitForFinished();
+    m_history->m_scheduler.shutdownWaitForFinished();
+    m_coins->m_scheduler.shutdownWaitForFinished();
+    syncScheduler()->unregisterWallet(this);
 
     if (status() == Status_Critical || status() == Status_BadPassword) {
         qDebug("Not storing wallet cache");
@@ -9,11 +9,14 @@
 
 #include "utils/scheduler.h"
 #include "PendingTransaction.h"
+#include "ConsolidationPlanner.h"
 #include "UnsignedTransaction.h"
 #include "utils/networktype.h"
 #include "PassphraseHelper.h"
 #include "rows/TxBacklogEntry.h"
+#include "ProofBatch.h"
 
+#include <functional>
 #include <set>
 
 class WalletListenerImpl;
@@ -74,8 +77,12 @@ class Subaddress;
 class SubaddressModel;
 class SubaddressAccount;
 class SubaddressAccountModel;
+class BalanceCache;
 class Coins;
 class CoinsModel;
+class FeeEstimator;
+class SyncMetrics;
+class TxSigner;
 
 struct TxProofResult {
     TxProofResult() {}
@@ -218,6 +225,9 @@ public:
     void startRefresh();
     void pauseRefresh();
 
+    //! Stops refreshing when the wallet's window closes, before the wallet is stored and destroyed
+    void beginClose();
+
     //! returns current wallet's block height
     //! (can be less than daemon's blockchain height when wallet sync in progress)
     quint64 blockChainHeight() const;
@@ -269,6 +279,13 @@ public:
     //! import a transaction
     bool importTransaction(const QString& txid);
 
+    //! import transactions with a single scan, txids should be in chronological order
+    bool importTransactions(const QStringList& txids);
+
+    //! look up transactions on the daemon through the wallet's own connection, found maps txids to their block
+    //! height, transactions in the pool to the maximum height. Returns false if the request failed.
+    bool lookupTransactions(const QStringList &txids, QHash<QString, quint64> &found, QString &error);
+
     // ##### Wallet cache #####
     //! saves wallet to the file by given path
     //! empty path stores in current location
@@ -326,6 +343,9 @@ public:
     void createTransactionMultiDest(const QVector<QString> &addresses, const QVector<quint64> &amounts, const QString &description, int feeLevel = 0, bool subtractFeeFromAmount = false);
     void sweepOutputs(const QVector<QString> &keyImages, QString address, bool churn, int outputs, int feeLevel = 0);
 
+    //! Emits consolidationPlanned
+    void planConsolidation(int maxInputs, bool mergeSubaddresses, int feeLevel = 0);
+
     void commitTransaction(PendingTransaction *tx, const QString &description="");
     void onTransactionCommitted(bool success, PendingTransaction *tx, const QStringList& txid, const QMap<QString, QString> &txHexMap);
 
@@ -346,6 +366,9 @@ public:
     //! Load an unsigned transaction from a base64 encoded string
     UnsignedTransaction * loadTxFromBase64Str(const QString &unsigned_tx);
 
+    //! Sign an unsigned transaction set on worker threads, the caller takes ownership
+    TxSigner * createTxSigner(const std::string &unsignedTx);
+
     //! Load a signed transaction from file
     PendingTransaction * loadSignedTxFile(const QString &fileName);
     PendingTransaction * loadSignedTxFromStr(const std::string &data);
@@ -367,6 +390,9 @@ public:
     SubaddressAccountModel* subaddressAccountModel() const;
     Coins* coins() const;
     CoinsModel* coinsModel() const;
+    FeeEstimator* feeEstimator() const;
+    SyncMetrics* syncMetrics() const;
+    BalanceCache* balanceCache() const;
 
     // ##### Transaction proofs #####
 
@@ -381,6 +407,9 @@ public:
     QPair<bool, bool> checkSpendProof(const QString &txid, const QString &message, const QString &signature) const;
     void checkSpendProofAsync(const QString &txid, const QString &message, const QString &signature);
 
+    //! Caller takes ownership of the returned batch
+    ProofBatch * createProofBatch(ProofBatch::Mode mode, const QList<ProofBatchEntry> &entries);
+
     // ##### Sign / Verify message #####
     //! signing a message
     QString signMessage(const QString &message, bool filename = false, const QString &address = "") const;
@@ -462,6 +491,10 @@ signals:
     void keysCorrupted();
 
     void transactionCreated(PendingTransaction *tx, const QVector<QString> &address);
+    //! Emitted by the confirmation flow when a created transaction is not committed: it failed to build or to pass
+    //! a check, or the user rejected it. The transaction may already be disposed of.
+    void transactionCancelled(PendingTransaction *tx);
+    void consolidationPlanned(const ConsolidationPlan &plan);
 
     void walletRefreshed();
 
@@ -478,16 +511,26 @@ private:
 
     // ##### Synchronization (Refresh) #####
     void startRefreshThread();
+    void contributeBlockHashes();
     void onNewBlock(uint64_t height);
     void onUpdated();
     void onRefreshed(bool success, const QString &message);
 
     // ##### Transactions #####
-    void onTransactionCreated(Monero::PendingTransaction *mtx, const QVector<QString> &address);
+    void refreshTxPoolStats();
+    using TransactionFactory = std::function<Monero::PendingTransaction*(const std::set<std::string> &inputs)>;
+    CoinSelector::FeeFunction feeFunction(int feeLevel, int numOutputs);
+    QVector<CoinCandidate> spendableCandidates();
+    CoinSelection selectInputs(quint64 amount, int numDestinations, int feeLevel, bool subtractFeeFromAmount);
+    Monero::PendingTransaction* createWithSelection(const TransactionFactory &create, CoinSelection &selection);
+    void onTransactionCreated(Monero::PendingTransaction *mtx, const QVector<QString> &address, const CoinSelection &selection = {});
 
 private:
     friend class WalletManager;
     friend class WalletListenerImpl;
+    friend class Subaddress;
+    friend class TransactionHistory;
+    friend class Coins;
 
     Monero::Wallet *m_walletImpl;
     tools::wallet2 *m_wallet2;
@@ -507,6 +550,8 @@ private:
     uint32_t m_currentSubaddressAccount;
     Subaddress *m_subaddress;
     SubaddressModel *m_subaddressModel;
+    BalanceCache *m_balanceCache;
+    quint64 m_lastScannedBlock = 0; // To notice the refresh thread going back to rescan detached blocks
     SubaddressAccount *m_subaddressAccount;
     SubaddressAccountModel *m_subaddressAccountModel;
 
@@ -518,16 +563,21 @@ private:
     QString m_daemonPassword;
 
     QMutex m_proxyMutex;
+    QString m_daemonAddress;
     std::atomic<bool> m_refreshNow;
     std::atomic<bool> m_refreshEnabled;
+    std::atomic<bool> m_closing = false;
     WalletListenerImpl *m_walletListener;
     FutureScheduler m_scheduler;
 
     bool m_useSSL;
     bool m_newWallet = false;
     bool m_forceKeyImageSync = false;
+    quint64 m_blockHashesContributedHeight = 0;
 
     QTimer *m_storeTimer = nullptr;
+    FeeEstimator *m_feeEstimator;
+    SyncMetrics *m_syncMetrics;
     std::set<std::string> m_selectedInputs;
 };
 
@@ -3,7 +3,6 @@
 
 #include "TransactionRow.h"
 #include "WalletManager.h"
-#include "Output.h"
 
 TransactionRow::TransactionRow()
         : amount(0)
@@ -11,6 +10,7 @@ TransactionRow::TransactionRow()
         , blockHeight(0)
         , confirmations(0)
         , direction(TransactionRow::Direction_Out)
+        , txid{}
         , subaddrAccount(0)
         , unlockTime(0)
         , failed(false)
@@ -52,26 +52,9 @@ QString TransactionRow::time() const
     return timestamp.time().toString(Qt::ISODate);
 }
 
-QList<QString> TransactionRow::destinations() const
+QString TransactionRow::hash() const
 {
-    QList<QString> dests;
-    for (auto const& t: transfers) {
-        dests.append(t.address);
-    }
-    return dests;
-}
-
-QString TransactionRow::rings_formatted() const
-{
-    QString ringsStr;
-    for (auto const& r: rings) {
-        ringsStr += r.keyImage + ": \n";
-        for (uint64_t m : r.ringMembers){
-            ringsStr += QString::number(m) + " ";
-        }
-        ringsStr += "\n\n";
-    }
-    return ringsStr;
+    return QString::fromLatin1(QByteArray::fromRawData(txid.data(), txid.size()).toHex());
 }
 
 bool TransactionRow::hasPaymentId() const {
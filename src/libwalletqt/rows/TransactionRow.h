@@ -4,8 +4,10 @@
 #ifndef FEATHER_TRANSACTIONROW_H
 #define FEATHER_TRANSACTIONROW_H
 
-#include <QSet>
 #include <QDateTime>
+#include <QVarLengthArray>
+
+#include <array>
 
 struct Ring
 {
@@ -26,19 +28,20 @@ struct TransactionRow
         Direction_Both // invalid direction value, used for filtering
     };
 
-    QList<Output> transfers;
-    QList<Ring> rings;
+    // Destinations and rings are not stored here, TransactionHistory::transfers() and TransactionHistory::rings()
+    // read them from the wallet when a detail view needs them.
+
     qint64 amount; // Amount that was sent (to destinations) or received, excludes tx fee
     qint64 balanceDelta; // How much the total balance was mutated as a result of this tx (includes tx fee)
     quint64 blockHeight;
     QString description;
     quint64 confirmations;
     Direction direction;
-    QString hash;
+    std::array<char, 32> txid; // raw tx hash, see hash() for the hex string
     QString label;
     QString paymentId;
     quint32 subaddrAccount;
-    QSet<quint32> subaddrIndex;
+    QVarLengthArray<quint32, 1> subaddrIndex; // sorted, nearly always a single index
     QDateTime timestamp;
     quint64 unlockTime;
     bool failed;
@@ -52,8 +55,7 @@ struct TransactionRow
     quint64 confirmationsRequired() const;
     QString date() const;
     QString time() const;
-    QList<QString> destinations() const;
-    QString rings_formatted() const;
+    QString hash() const;
     bool hasPaymentId() const;
 
     explicit TransactionRow();
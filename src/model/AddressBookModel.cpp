@@ -13,6 +13,17 @@ AddressBookModel::AddressBookModel(QObject *parent, AddressBook *addressBook)
 {
     connect(m_addressBook, &AddressBook::refreshStarted, this, &AddressBookModel::beginResetModel);
     connect(m_addressBook, &AddressBook::refreshFinished, this, &AddressBookModel::endResetModel);
+    connect(m_addressBook, &AddressBook::beginAddRow, this, [this](qsizetype index) {
+        this->beginInsertRows(QModelIndex(), index, index);
+    });
+    connect(m_addressBook, &AddressBook::endAddRow, this, &AddressBookModel::endInsertRows);
+    connect(m_addressBook, &AddressBook::beginRemoveRow, this, [this](qsizetype index) {
+        this->beginRemoveRows(QModelIndex(), index, index);
+    });
+    connect(m_addressBook, &AddressBook::endRemoveRow, this, &AddressBookModel::endRemoveRows);
+    connect(m_addressBook, &AddressBook::rowUpdated, this, [this](qsizetype index) {
+        emit dataChanged(this->index(index, 0), this->index(index, COUNT - 1), {Qt::DisplayRole, Qt::EditRole});
+    });
     m_contactIcon = icons()->icon("person.svg");
 }
 
@@ -58,14 +69,11 @@ bool AddressBookModel::setData(const QModelIndex &index, const QVariant &value,
 
     switch (index.column()) {
         case Description:
-            m_addressBook->setDescription(row, value.toString());
-            break;
+            // AddressBook emits rowUpdated on success
+            return m_addressBook->setDescription(row, value.toString());
         default:
             return false;
     }
-    emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
-
-    return true;
 }
 
 QVariant AddressBookModel::data(const QModelIndex &index, int role) const
@@ -222,7 +222,7 @@ void HistoryView::keyPressEvent(QKeyEvent *event) {
     const TransactionRow& tx = sourceModel()->entryFromIndex(index);
 
     if (event->matches(QKeySequence::Copy)) {
-        Utils::copyToClipboard(tx.hash);
+        Utils::copyToClipboard(tx.hash());
     }
     else {
         QTreeView::keyPressEvent(event);
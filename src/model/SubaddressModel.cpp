@@ -27,6 +27,7 @@ SubaddressModel::SubaddressModel(QObject *parent, Subaddress *subaddress)
     connect(m_subaddress, &Subaddress::beginAddRow, this, &SubaddressModel::beginRowAdded);
     connect(m_subaddress, &Subaddress::endAddRow, this, &SubaddressModel::endInsertRows);
     connect(m_subaddress, &Subaddress::rowUpdated, this, &SubaddressModel::rowUpdated);
+    connect(m_subaddress, &Subaddress::rowsUpdated, this, &SubaddressModel::rowsUpdated);
 }
 
 int SubaddressModel::rowCount(const QModelIndex &parent) const
@@ -61,7 +62,13 @@ QVariant SubaddressModel::data(const QModelIndex &index, int role) const
         return {};
     }
     const SubaddressRow& row = rows[index.row()];
-    
+
+    // Addresses are derived on demand, only for rows whose address the view actually shows. Sorting and
+    // filtering go through other columns and roles and must not derive every row.
+    if (row.address.isEmpty() && index.column() == ModelColumn::Address && (role == Qt::DisplayRole || role == Qt::EditRole)) {
+        m_subaddress->requestAddress(index.row());
+    }
+
     if (role == Qt::DisplayRole || role == Qt::EditRole || role == Qt::UserRole){
         return parseSubaddressRow(row, index, role);
     }
@@ -247,6 +254,20 @@ void SubaddressModel::rowUpdated(qsizetype index)
     emit dataChanged(this->index(index, 0), this->index(index, SubaddressModel::COUNT - 1), {Qt::DisplayRole, Qt::EditRole});
 }
 
+void SubaddressModel::rowsUpdated(qsizetype first, qsizetype last)
+{
+    if (!m_subaddress) {
+        return;
+    }
+
+    if (first < 0 || last < first || last >= m_subaddress->count()) {
+        qCritical() << "SubaddressModel::rowsUpdated: Range out of bounds:" << first << last;
+        return;
+    }
+
+    emit dataChanged(this->index(first, 0), this->index(last, SubaddressModel::COUNT - 1), {Qt::DisplayRole, Qt::EditRole});
+}
+
 void SubaddressModel::beginRowAdded(qsizetype index)
 {
     if (!m_subaddress) {
@@ -37,6 +37,7 @@ public:
     const SubaddressRow& entryFromIndex(const QModelIndex &index) const;
 
     void rowUpdated(qsizetype index);
+    void rowsUpdated(qsizetype first, qsizetype last);
     void beginRowAdded(qsizetype index);
 
 private:
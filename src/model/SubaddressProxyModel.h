@@ -20,6 +20,10 @@ public slots:
     void setSearchFilter(const QString& searchString){
         m_searchRegExp.setPattern(searchString);
         m_searchCaseSensitiveRegExp.setPattern(searchString);
+        if (!searchString.isEmpty()) {
+            // Rows are filtered again as their addresses come in
+            m_subaddress->requestAllAddresses();
+        }
         invalidateFilter();
     }
 
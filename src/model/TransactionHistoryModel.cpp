@@ -126,6 +126,17 @@ QVariant TransactionHistoryModel::data(const QModelIndex &index, int role) const
     return {};
 }
 
+double TransactionHistoryModel::usdToFiatRate(const QString &fiatCurrency) const {
+    const auto &prices = appData()->prices;
+    if (prices.version() != m_pricesVersion || fiatCurrency != m_fiatCurrency) {
+        auto snapshot = prices.snapshot();
+        m_pricesVersion = snapshot->version();
+        m_fiatCurrency = fiatCurrency;
+        m_usdToFiat = snapshot->rate(snapshot->currencyId("USD"), snapshot->currencyId(fiatCurrency));
+    }
+    return m_usdToFiat;
+}
+
 QVariant TransactionHistoryModel::parseTransactionInfo(const TransactionRow &tInfo, int column, int role) const
 {
     switch (column)
@@ -154,9 +165,9 @@ QVariant TransactionHistoryModel::parseTransactionInfo(const TransactionRow &tIn
         }
         case Column::TxID: {
             if (conf()->get(Config::historyShowFullTxid).toBool()) {
-                return tInfo.hash;
+                return tInfo.hash();
             }
-            return Utils::displayAddress(tInfo.hash, 1);
+            return Utils::displayAddress(tInfo.hash(), 1);
         }
         case Column::FiatAmount:
         {
@@ -169,7 +180,7 @@ QVariant TransactionHistoryModel::parseTransactionInfo(const TransactionRow &tIn
 
             QString preferredFiatCurrency = conf()->get(Config::preferredFiatCurrency).toString();
             if (preferredFiatCurrency != "USD") {
-                usd_amount = appData()->prices.convert("USD", preferredFiatCurrency, usd_amount);
+                usd_amount *= this->usdToFiatRate(preferredFiatCurrency);
             }
             if (role == Qt::UserRole) {
                 return usd_amount;
@@ -219,7 +230,7 @@ bool TransactionHistoryModel::setData(const QModelIndex &index, const QVariant &
             case Column::Description:
             {
                 const TransactionRow& row = m_transactionHistory->transaction(index.row());
-                m_transactionHistory->setTxNote(row.hash, value.toString());
+                m_transactionHistory->setTxNote(row.hash(), value.toString());
                 m_transactionHistory->refresh();
                 emit transactionDescriptionChanged();
                 break;
@@ -48,7 +48,14 @@ signals:
 private:
     QVariant parseTransactionInfo(const TransactionRow &tInfo, int column, int role) const;
 
+    //! Cached until prices or the preferred currency change, the fiat column asks for every row on every repaint
+    double usdToFiatRate(const QString &fiatCurrency) const;
+
     TransactionHistory * m_transactionHistory;
+
+    mutable quint64 m_pricesVersion = 0;
+    mutable QString m_fiatCurrency;
+    mutable double m_usdToFiat = 0.0;
 };
 
 #endif // TRANSACTIONHISTORYMODEL_H
@@ -19,26 +19,79 @@ TransactionHistory* TransactionHistoryProxyModel::history() {
     return m_history;
 }
 
+void TransactionHistoryProxyModel::setSearchFilter(const QString &searchString) {
+    static const QRegularExpression hexRe("^[0-9a-fA-F]+$");
+
+    m_searchRegExp.setPattern(searchString);
+    m_searchNibbles.clear();
+
+    if (hexRe.match(searchString).hasMatch()) {
+        m_txidSearch = TxidSearch::Nibbles;
+        for (QChar c : searchString) {
+            m_searchNibbles.append(static_cast<char>(QString(c).toUInt(nullptr, 16)));
+        }
+    }
+    else if (QRegularExpression::escape(searchString) == searchString) {
+        // Plain text with letters outside a-f
+        m_txidSearch = TxidSearch::None;
+    }
+    else {
+        m_txidSearch = TxidSearch::Regex;
+    }
+
+    invalidateFilter();
+}
+
+static bool containsNibbles(const std::array<char, 32> &txid, const QByteArray &nibbles) {
+    auto nibble = [&txid](int i) {
+        const auto byte = static_cast<quint8>(txid[i / 2]);
+        return (i % 2 == 0) ? (byte >> 4) : (byte & 0x0F);
+    };
+
+    const int length = static_cast<int>(txid.size()) * 2;
+    for (int start = 0; start + nibbles.size() <= length; start++) {
+        int i = 0;
+        while (i < nibbles.size() && nibble(start + i) == nibbles[i]) {
+            i++;
+        }
+        if (i == nibbles.size()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool TransactionHistoryProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
     if (sourceRow < 0 || sourceRow >= m_history->count()) {
         return false;
     }
 
+    if (m_searchRegExp.pattern().isEmpty()) {
+        return true;
+    }
+
     const TransactionRow& row = m_history->transaction(sourceRow);
 
     QString description = row.description;
-    QString txid = row.hash;
     QString subaddrlabel = row.label;
     quint32 subaddrAccount = row.subaddrAccount;
-    QSet<quint32> subaddrIndex = row.subaddrIndex;
 
-    bool addressFound;
-    for (quint32 i : subaddrIndex) {
+    // Hex encoding every row on every pass is what makes filtering a long history slow
+    bool txidFound = false;
+    if (m_txidSearch == TxidSearch::Nibbles) {
+        txidFound = containsNibbles(row.txid, m_searchNibbles);
+    }
+    else if (m_txidSearch == TxidSearch::Regex) {
+        txidFound = row.hash().contains(m_searchRegExp);
+    }
+
+    bool addressFound = false;
+    for (quint32 i : row.subaddrIndex) {
         QString address = m_wallet->address(subaddrAccount, i);
         addressFound = address.contains(m_searchRegExp);
         if (addressFound) break;
     }
     
-    return (description.contains(m_searchRegExp) || txid.contains(m_searchRegExp) || subaddrlabel.contains(m_searchRegExp)) || addressFound;
+    return (description.contains(m_searchRegExp) || txidFound || subaddrlabel.contains(m_searchRegExp)) || addressFound;
 }
@@ -18,16 +18,22 @@ public:
     TransactionHistory* history();
 
 public slots:
-    void setSearchFilter(const QString& searchString){
-        m_searchRegExp.setPattern(searchString);
-        invalidateFilter();
-    }
+    void setSearchFilter(const QString& searchString);
 
 private:
+    // How the search pattern is matched against the raw tx hash, decided once per pattern
+    enum class TxidSearch {
+        None,    // can't match a hex string
+        Nibbles, // plain hex, compared against the raw bytes
+        Regex    // regular expression, needs the hex string
+    };
+
     Wallet *m_wallet;
     TransactionHistory *m_history;
 
     QRegularExpression m_searchRegExp;
+    TxidSearch m_txidSearch = TxidSearch::None;
+    QByteArray m_searchNibbles;
 };
 
 #endif //FEATHER_TRANSACTIONHISTORYPROXYMODEL_H
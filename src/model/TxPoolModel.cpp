@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "TxPoolModel.h"
+
+#include <QBrush>
+#include <QHash>
+
+#include "libwalletqt/WalletManager.h"
+#include "utils/ColorScheme.h"
+
+TxPoolModel::TxPoolModel(QObject *parent)
+        : QAbstractTableModel(parent)
+{
+}
+
+int TxPoolModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_order.size();
+}
+
+int TxPoolModel::columnCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return ModelColumn::COUNT;
+}
+
+QVariant TxPoolModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_order.size()) {
+        return {};
+    }
+
+    int entry = m_order[index.row()];
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case Weight:
+                return QString("%1 B").arg(QString::number(m_weight[entry]));
+            case Fee:
+                return QString("%1 XMR").arg(WalletManager::displayAmount(m_fee[entry]));
+            case FeePerByte:
+                return QString::number(m_feePerByte[entry]);
+            default:
+                return {};
+        }
+    }
+    else if (role == Qt::UserRole) {
+        return this->value(index.column(), entry);
+    }
+    else if (role == Qt::TextAlignmentRole) {
+        return Qt::AlignRight;
+    }
+    else if (role == Qt::BackgroundRole) {
+        if (index.column() != FeePerByte || m_baseFees.size() != 4) {
+            return {};
+        }
+
+        quint64 feePerByte = m_feePerByte[entry];
+        if (feePerByte == m_baseFees[3]) {
+            return QBrush(ColorScheme::RED.asColor(true));
+        }
+        if (feePerByte == m_baseFees[2]) {
+            return QBrush(ColorScheme::YELLOW.asColor(true));
+        }
+        if (feePerByte == m_baseFees[1]) {
+            return QBrush(ColorScheme::GREEN.asColor(true));
+        }
+        if (feePerByte == m_baseFees[0]) {
+            return QBrush(ColorScheme::BLUE.asColor(true));
+        }
+    }
+
+    return {};
+}
+
+QVariant TxPoolModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal) {
+        return {};
+    }
+
+    if (role == Qt::TextAlignmentRole) {
+        return Qt::AlignRight;
+    }
+
+    if (role != Qt::DisplayRole) {
+        return {};
+    }
+
+    switch (section) {
+        case Weight:
+            return QString("Weight");
+        case Fee:
+            return QString("Fee");
+        case FeePerByte:
+            return QString("Fee / B");
+        default:
+            return {};
+    }
+}
+
+void TxPoolModel::sort(int column, Qt::SortOrder order) {
+    if (column < 0 || column >= ModelColumn::COUNT) {
+        return;
+    }
+
+    m_sortColumn = column;
+    m_sortOrder = order;
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    QModelIndexList oldPersistent = this->persistentIndexList();
+    QVector<int> oldEntries;
+    oldEntries.reserve(oldPersistent.size());
+    for (const auto &index : oldPersistent) {
+        oldEntries.append(m_order[index.row()]);
+    }
+
+    this->sortOrder();
+
+    if (!oldPersistent.isEmpty()) {
+        QVector<int> rowOf(m_weight.size());
+        for (int row = 0; row < m_order.size(); row++) {
+            rowOf[m_order[row]] = row;
+        }
+
+        QModelIndexList newPersistent;
+        newPersistent.reserve(oldPersistent.size());
+        for (int i = 0; i < oldPersistent.size(); i++) {
+            newPersistent.append(this->index(rowOf[oldEntries[i]], oldPersistent[i].column()));
+        }
+        this->changePersistentIndexList(oldPersistent, newPersistent);
+    }
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void TxPoolModel::updateBacklog(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees) {
+    bool baseFeesChanged = (baseFees != m_baseFees);
+    m_baseFees = baseFees;
+
+    // The backlog carries no txids, so entries are matched on (weight, fee)
+    QHash<std::pair<quint64, quint64>, int> incoming;
+    incoming.reserve(txPool.size());
+    for (const auto &entry : txPool) {
+        incoming[{entry.weight, entry.fee}] += 1;
+    }
+
+    QVector<bool> keep(m_weight.size(), false);
+    int removed = 0;
+    for (int i = 0; i < m_weight.size(); i++) {
+        auto it = incoming.find({m_weight[i], m_fee[i]});
+        if (it != incoming.end() && it.value() > 0) {
+            keep[i] = true;
+            it.value() -= 1;
+        } else {
+            removed += 1;
+        }
+    }
+
+    if (removed > m_order.size() / 2) {
+        // Most of the pool was replaced (e.g. a block was mined), a reset is cheaper than removing row ranges
+        beginResetModel();
+        m_weight.clear();
+        m_fee.clear();
+        m_feePerByte.clear();
+        m_order.clear();
+        for (const auto &entry : txPool) {
+            m_order.append(m_weight.size());
+            m_weight.append(entry.weight);
+            m_fee.append(entry.fee);
+            m_feePerByte.append(entry.weight > 0 ? entry.fee / entry.weight : 0);
+        }
+        this->sortOrder();
+        endResetModel();
+    }
+    else {
+        if (removed > 0) {
+            this->removeEntries(keep);
+        }
+
+        int added = 0;
+        for (auto it = incoming.cbegin(); it != incoming.cend(); ++it) {
+            added += it.value();
+        }
+
+        if (added > 0) {
+            beginInsertRows(QModelIndex(), m_order.size(), m_order.size() + added - 1);
+            for (auto it = incoming.cbegin(); it != incoming.cend(); ++it) {
+                auto [weight, fee] = it.key();
+                for (int i = 0; i < it.value(); i++) {
+                    m_order.append(m_weight.size());
+                    m_weight.append(weight);
+                    m_fee.append(fee);
+                    m_feePerByte.append(weight > 0 ? fee / weight : 0);
+                }
+            }
+            endInsertRows();
+
+            this->sort(m_sortColumn, m_sortOrder);
+        }
+
+        if (baseFeesChanged && !m_order.isEmpty()) {
+            emit dataChanged(this->index(0, FeePerByte), this->index(m_order.size() - 1, FeePerByte), {Qt::BackgroundRole});
+        }
+    }
+
+    m_totalWeight = 0;
+    m_totalFees = 0;
+    for (int i = 0; i < m_weight.size(); i++) {
+        m_totalWeight += m_weight[i];
+        m_totalFees += m_fee[i];
+    }
+}
+
+quint64 TxPoolModel::totalWeight() const {
+    return m_totalWeight;
+}
+
+quint64 TxPoolModel::totalFees() const {
+    return m_totalFees;
+}
+
+quint64 TxPoolModel::value(int column, int entry) const {
+    switch (column) {
+        case Weight:
+            return m_weight[entry];
+        case Fee:
+            return m_fee[entry];
+        case FeePerByte:
+            return m_feePerByte[entry];
+        default:
+            return 0;
+    }
+}
+
+void TxPoolModel::removeEntries(const QVector<bool> &keep) {
+    // Remove rows bottom-up in contiguous view ranges
+    int row = m_order.size() - 1;
+    while (row >= 0) {
+        if (keep[m_order[row]]) {
+            row -= 1;
+            continue;
+        }
+
+        int last = row;
+        while (row > 0 && !keep[m_order[row - 1]]) {
+            row -= 1;
+        }
+
+        beginRemoveRows(QModelIndex(), row, last);
+        m_order.remove(row, last - row + 1);
+        endRemoveRows();
+
+        row -= 1;
+    }
+
+    // Compact storage, rows keep their position
+    QVector<int> remap(keep.size(), -1);
+    int n = 0;
+    for (int i = 0; i < keep.size(); i++) {
+        if (!keep[i]) {
+            continue;
+        }
+        remap[i] = n;
+        m_weight[n] = m_weight[i];
+        m_fee[n] = m_fee[i];
+        m_feePerByte[n] = m_feePerByte[i];
+        n += 1;
+    }
+    m_weight.resize(n);
+    m_fee.resize(n);
+    m_feePerByte.resize(n);
+
+    for (int &entry : m_order) {
+        entry = remap[entry];
+    }
+}
+
+void TxPoolModel::sortOrder() {
+    const int column = m_sortColumn;
+    const bool ascending = (m_sortOrder == Qt::AscendingOrder);
+
+    std::stable_sort(m_order.begin(), m_order.end(), [this, column, ascending](int a, int b) {
+        quint64 va = this->value(column, a);
+        quint64 vb = this->value(column, b);
+        return ascending ? va < vb : va > vb;
+    });
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_TXPOOLMODEL_H
+#define FEATHER_TXPOOLMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+
+#include "libwalletqt/rows/TxBacklogEntry.h"
+
+// Table model over a flat copy of the tx pool backlog. Rows are stored as parallel columns and displayed
+// through a permutation, so sorting and refreshing never touch per-row objects and formatting is only
+// done for the rows the view asks for.
+class TxPoolModel : public QAbstractTableModel
+{
+Q_OBJECT
+
+public:
+    enum ModelColumn {
+        Weight = 0,
+        Fee,
+        FeePerByte,
+        COUNT
+    };
+
+    explicit TxPoolModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+    void sort(int column, Qt::SortOrder order) override;
+
+    //! Applies a new backlog snapshot, only inserting and removing the rows that changed
+    void updateBacklog(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees);
+
+    quint64 totalWeight() const;
+    quint64 totalFees() const;
+
+private:
+    quint64 value(int column, int entry) const;
+    void removeEntries(const QVector<bool> &keep);
+    void sortOrder();
+
+    // Struct-of-arrays storage, indexed by entry
+    QVector<quint64> m_weight;
+    QVector<quint64> m_fee;
+    QVector<quint64> m_feePerByte;
+
+    // View row -> entry
+    QVector<int> m_order;
+
+    QVector<quint64> m_baseFees;
+    quint64 m_totalWeight = 0;
+    quint64 m_totalFees = 0;
+
+    int m_sortColumn = FeePerByte;
+    Qt::SortOrder m_sortOrder = Qt::DescendingOrder;
+};
+
+#endif //FEATHER_TXPOOLMODEL_H
@@ -0,0 +1,116 @@
+/*
+	Micro-benchmark for reed_solomon_code::check, the checksum test every seed decode and every seed
+	recovery candidate goes through. Built with -DWITH_BENCHMARKS=ON.
+
+	"syndrome" is the previous path: a syndrome polynomial filled by Horner evaluation at exp(i).
+	"check" is the current path: gf_poly::eval_exp with one table lookup per coefficient.
+	Both run on the compile-time tables, table construction is not part of the comparison.
+*/
+
+#include <monero_seed/gf_poly.hpp>
+#include <monero_seed/reed_solomon_code.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static constexpr unsigned check_digits = 1;
+static constexpr unsigned phrase_words = gf_poly::max_degree + 1;
+/* Small enough to stay in cache, so the table lookups are measured rather than memory bandwidth */
+static constexpr size_t message_count = 256;
+static constexpr size_t rounds = 8000;
+static constexpr size_t runs = 9;
+
+/* gf_2048::mult before the tables became constexpr */
+static gf_item old_mult(gf_item a, gf_item b) {
+	if (b == 0 || a == 0)
+		return 0;
+	if (b == 1)
+		return a;
+	if (a == 1)
+		return b;
+	return gf_elem(gf_elem(a).log() + gf_elem(b).log()).exp().value();
+}
+
+/* gf_poly::operator() before eval_exp: Horner's method, out of line in gf_poly.cpp */
+[[gnu::noinline]] static gf_elem horner(const gf_poly& poly, gf_elem x) {
+	if (x == 0) {
+		return poly[0];
+	}
+	auto result = poly[poly.degree()];
+	for (unsigned i = poly.degree() - 1; i < poly.degree(); --i) {
+		result = gf_elem(old_mult(result.value(), x.value())) + poly[i];
+	}
+	return result;
+}
+
+/* reed_solomon_code::check before eval_exp: builds the syndrome polynomial */
+[[gnu::noinline]] static bool syndrome_check(const gf_poly& message, unsigned degree) {
+	gf_poly syndrome;
+	for (unsigned i = 1; i <= degree; ++i) {
+		syndrome[i - 1] = horner(message, gf_elem(i).exp());
+	}
+	return syndrome.is_zero();
+}
+
+/* Best of several runs, the machine is rarely quiet enough for a single one */
+template<typename F>
+static double measure(const char* name, const std::vector<gf_poly>& messages, F check) {
+	double best = 0;
+	size_t valid = 0;
+	for (size_t run = 0; run < runs; ++run) {
+		valid = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t r = 0; r < rounds; ++r) {
+			for (const auto& message : messages) {
+				valid += check(message);
+			}
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		double ns = std::chrono::duration<double, std::nano>(elapsed).count() / (rounds * messages.size());
+		if (run == 0 || ns < best) {
+			best = ns;
+		}
+	}
+	std::cout << name << ": " << best << " ns/check (" << valid / rounds << " of " << messages.size() << " valid)" << std::endl;
+	return best;
+}
+
+int main() {
+	const reed_solomon_code rs(check_digits);
+
+	// Half of the messages are valid code words, the other half have one word changed
+	std::mt19937 rng(2048);
+	std::uniform_int_distribution<unsigned> word(0, gf_elem::size() - 1);
+	std::vector<gf_poly> messages(message_count);
+	for (size_t i = 0; i < message_count; ++i) {
+		gf_poly& message = messages[i];
+		for (unsigned j = 0; j < phrase_words - check_digits; ++j) {
+			message[j] = word(rng);
+		}
+		message.set_degree();
+		rs.encode(message);
+		if (i % 2 == 1) {
+			message[check_digits + i % (phrase_words - check_digits)] += 1;
+			message.set_degree();
+		}
+	}
+
+	for (const auto& message : messages) {
+		if (syndrome_check(message, check_digits) != rs.check(message)) {
+			std::cerr << "check results differ" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	double before = measure("syndrome", messages, [](const gf_poly& message) {
+		return syndrome_check(message, check_digits);
+	});
+	double after = measure("check", messages, [&rs](const gf_poly& message) {
+		return rs.check(message);
+	});
+	std::cout << "speedup: " << before / after << "x" << std::endl;
+	return EXIT_SUCCESS;
+}
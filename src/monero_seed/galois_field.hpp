@@ -10,38 +10,67 @@
 typedef uint_least16_t gf_storage;
 typedef uint_fast16_t gf_item;
 
+/* The tables are built at compile time, so fields can be used during static initialization */
 template<unsigned bits, gf_item primitive>
 class galois_field {
 public:
-	galois_field();
-	gf_item inverse(gf_item i) const {
+	constexpr galois_field() {
+		gf_item b = 1;
+		for (gf_item i = 0; i < size_; ++i) {
+			log_table[b] = i;
+			exp_table[i] = b;
+			b <<= 1;
+			if ((b & size_) != 0)
+				b ^= primitive;
+		}
+		for (auto i = size_ - 1; i < (2 * size_); ++i) {
+			exp_table[i] = exp_table[i - (size_ - 1)];
+		}
+		/* a^-1 = exp(order - log(a)) */
+		inv_table[1] = 1;
+		for (gf_item i = 2; i < size_; i++) {
+			inv_table[i] = exp_table[order_ - log_table[i]];
+		}
+	}
+	constexpr gf_item inverse(gf_item i) const {
 		assert(i != 0);
 		return i > 1 ? inv_table[i] : 1;
 	}
-	gf_item mult(gf_item a, gf_item b) const {
+	constexpr gf_item mult(gf_item a, gf_item b) const {
 		if (b == 0 || a == 0)
 			return 0;
-		if (b == 1)
-			return a;
-		if (a == 1)
-			return b;
 		return exp_table[log_table[a] + log_table[b]];
 	}
-	gf_item exp(gf_item i) const {
+	/* a * exp(e) */
+	constexpr gf_item mult_exp(gf_item a, unsigned e) const {
+		if (a == 0)
+			return 0;
+		return exp_table[log_table[a] + e % order_];
+	}
+	constexpr gf_item exp(gf_item i) const {
 		return exp_table[i];
 	}
+	constexpr gf_item log(gf_item i) const {
+		assert(i != 0);
+		return log_table[i];
+	}
 	static constexpr unsigned size() {
 		return bits;
 	}
 	static constexpr unsigned elements() {
 		return size_;
 	}
+	/* order of the multiplicative group */
+	static constexpr unsigned order() {
+		return order_;
+	}
 private:
 	static_assert(bits <= 14, "field is too large");
 	static constexpr gf_item size_ = 1u << bits;
-	gf_storage log_table[size_];
-	gf_storage exp_table[2 * size_];
-	gf_storage inv_table[size_];
+	static constexpr gf_item order_ = size_ - 1;
+	gf_storage log_table[size_] = { };
+	gf_storage exp_table[2 * size_] = { };
+	gf_storage inv_table[size_] = { };
 };
 
 using gf_2048 = galois_field<11, 2053>;
@@ -1,8 +0,0 @@
-/*
-	Copyright (c) 2020 tevador <tevador@gmail.com>
-	All rights reserved.
-*/
-
-#include <monero_seed/gf_elem.hpp>
-
-const gf_2048 gf_elem::field;
@@ -59,10 +59,20 @@ public:
         value_ = field.exp(value_);
         return *this;
     }
+    gf_elem& mult_exp(unsigned e) {
+        value_ = field.mult_exp(value_, e);
+        return *this;
+    }
+    gf_item log() const {
+        return field.log(value_);
+    }
     gf_item value() const {
         return value_;
     }
+    static constexpr unsigned order() {
+        return gf_2048::order();
+    }
 private:
-	static const gf_2048 field;
+	static constexpr gf_2048 field = gf_2048();
 	gf_item value_;
 };
@@ -85,10 +85,19 @@ gf_elem gf_poly::operator()(gf_elem x) const {
 	if (x == 0) {
 		return coeff_[0];
 	}
-	//Horner's method
-	auto result = coeff_[degree_];
-	for (unsigned i = degree_ - 1; i < degree_; --i) {
-		result = result * x + coeff_[i];
+	return eval_exp(x.log());
+}
+
+gf_elem gf_poly::eval_exp(unsigned k) const {
+	//sum(c_i * x^i) with x^i = exp(i * k), one table lookup per term
+	gf_elem result;
+	unsigned e = 0;
+	k %= gf_elem::order();
+	for (unsigned i = 0; i <= degree_; ++i) {
+		result += gf_elem(coeff_[i]).mult_exp(e);
+		e += k;
+		if (e >= gf_elem::order())
+			e -= gf_elem::order();
 	}
 	return result;
 }
@@ -37,6 +37,7 @@ public:
 		return coeff_[i];
 	}
 	gf_elem operator()(gf_elem x) const; //evaluate at point x
+	gf_elem eval_exp(unsigned k) const; //evaluate at point exp(k)
 	gf_poly& operator+=(const gf_poly& x);
 	gf_poly& operator-=(const gf_poly& x);
 	gf_poly& operator*=(gf_elem x);
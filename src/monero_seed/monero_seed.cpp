@@ -19,6 +19,8 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <cstring>
+#include <vector>
 
 const std::string monero_seed::erasure = "xxxx";
 
@@ -117,6 +119,30 @@ static gf_elem get_coin_flag(const std::string& coin) {
 
 static const reed_solomon_code rs(check_digits);
 
+/* Reads everything after the checksum from a message that passed the check */
+static void read_payload(gf_poly& message, unsigned& reserved, unsigned& quantized_date, monero_seed::secret_seed& seed) {
+	unsigned used_bits = checksum_size;
+	reserved = 0;
+	quantized_date = 0;
+	seed.fill(0);
+
+	read_data(message, used_bits, reserved, reserved_bits);
+	read_data(message, used_bits, quantized_date, date_bits);
+
+	for (uint8_t& byte : seed) {
+		read_data(message, used_bits, byte, CHAR_BIT);
+	}
+
+	assert(used_bits == total_bits);
+}
+
+static void make_salt(uint8_t (&salt)[25], unsigned reserved, unsigned quantized_date) {
+	memset(salt, 0, sizeof(salt));
+	memcpy(salt, "Monero 14-word seed", 19);
+	salt[20] = reserved;
+	store32(salt + 21, quantized_date);
+}
+
 monero_seed::monero_seed(std::time_t date_created, const std::string& coin) {
 	if (date_created < epoch) {
 		THROW_EXCEPTION("date_created must not be before 1st June 2020");
@@ -126,9 +152,8 @@ monero_seed::monero_seed(std::time_t date_created, const std::string& coin) {
 	gf_elem coin_flag = get_coin_flag(coin);
 	reserved_ = 0;
 	secure_random::gen_bytes(seed_.data(), seed_.size());
-	uint8_t salt[25] = "Monero 14-word seed";
-	salt[20] = reserved_;
-	store32(salt + 21, quantized_date);
+	uint8_t salt[25];
+	make_salt(salt, reserved_, quantized_date);
 	//argon2id_hash_raw(argon_tcost, argon_mcost, 1, seed_.data(), seed_.size(), salt, sizeof(salt), key_.data(), key_.size());
 	pbkdf2_hmac_sha256(seed_.data(), seed_.size(), salt, sizeof(salt), pbkdf2_iterations, key_.data(), key_.size());
 	unsigned rem_bits = gf_elem::size();
@@ -194,20 +219,8 @@ monero_seed::monero_seed(const std::string& phrase, const std::string& coin) {
 		}
 	}
 
-	unsigned used_bits = checksum_size;
 	unsigned quantized_date;
-	reserved_ = 0;
-	quantized_date = 0;
-	memset(seed_.data(), 0, seed_.size());
-
-	read_data(message_, used_bits, reserved_, reserved_bits);
-	read_data(message_, used_bits, quantized_date, date_bits);
-
-	for (uint8_t& byte : seed_) {
-		read_data(message_, used_bits, byte, CHAR_BIT);
-	}
-
-	assert(used_bits == total_bits);
+	read_payload(message_, reserved_, quantized_date, seed_);
 
 	if (reserved_ != 0) {
 		THROW_EXCEPTION("reserved bits must be zero");
@@ -215,13 +228,60 @@ monero_seed::monero_seed(const std::string& phrase, const std::string& coin) {
 
 	date_ = epoch + quantized_date * time_step;
 
-	uint8_t salt[25] = "Monero 14-word seed";
-	salt[20] = reserved_;
-	store32(salt + 21, quantized_date);
+	uint8_t salt[25];
+	make_salt(salt, reserved_, quantized_date);
 	//argon2id_hash_raw(argon_tcost, argon_mcost, 1, seed_.data(), seed_.size(), salt, sizeof(salt), key_.data(), key_.size());
 	pbkdf2_hmac_sha256(seed_.data(), seed_.size(), salt, sizeof(salt), pbkdf2_iterations, key_.data(), key_.size());
 }
 
+gf_elem monero_seed::checksum_target(const std::string& coin) {
+	//the coin flag is added to the first data word before the checksum is verified
+	return get_coin_flag(coin) * gf_elem(1).exp();
+}
+
+bool monero_seed::decode_candidate(const phrase& words, const std::string& coin,
+	std::time_t max_date, recovery_candidate& candidate)
+{
+	static_assert(phrase_size == phrase_words, "Invalid phrase size");
+	gf_poly message;
+	for (unsigned i = 0; i < phrase_words; ++i) {
+		message[i] = words[i];
+	}
+	message.set_degree();
+	message[check_digits] += get_coin_flag(coin);
+	if (!rs.check(message)) {
+		return false;
+	}
+
+	unsigned reserved;
+	unsigned quantized_date;
+	read_payload(message, reserved, quantized_date, candidate.seed);
+	if (reserved != 0) {
+		return false;
+	}
+	std::time_t date = epoch + quantized_date * time_step;
+	if (date > max_date) {
+		return false;
+	}
+
+	candidate.words = words;
+	candidate.date = date;
+	make_salt(candidate.salt, reserved, quantized_date);
+	return true;
+}
+
+void monero_seed::derive_keys(recovery_candidate* candidates, size_t count) {
+	std::vector<pbkdf2_job> jobs(count);
+	for (size_t i = 0; i < count; ++i) {
+		jobs[i].password = candidates[i].seed.data();
+		jobs[i].pw_size = candidates[i].seed.size();
+		jobs[i].salt = candidates[i].salt;
+		jobs[i].salt_size = sizeof(candidates[i].salt);
+		jobs[i].key = candidates[i].key.data();
+	}
+	pbkdf2_hmac_sha256_batch(jobs.data(), count, pbkdf2_iterations, key_size);
+}
+
 std::ostream& operator<<(std::ostream& os, const monero_seed& seed) {
 	for (int i = 0; i <= seed.message_.degree(); ++i) {
 		if (i > 0) {
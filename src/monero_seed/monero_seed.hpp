@@ -16,8 +16,25 @@ public:
 	static const std::string erasure;
 	static constexpr size_t size = 16;
 	static constexpr size_t key_size = 32;
+	static constexpr size_t phrase_size = 14;
 	using secret_key = std::array<uint8_t, key_size>;
 	using secret_seed = std::array<uint8_t, size>;
+	using phrase = std::array<gf_item, phrase_size>;
+	/* A phrase decoded for recovery, the key is filled in by derive_keys */
+	struct recovery_candidate {
+		phrase words;
+		secret_seed seed;
+		uint8_t salt[25];
+		std::time_t date;
+		secret_key key;
+	};
+	/* A phrase is valid if sum(words[i] * a^i) equals this value */
+	static gf_elem checksum_target(const std::string& coin);
+	/* Decodes a phrase without running the KDF. Fails on a checksum mismatch,
+	   reserved bits or a creation date after max_date. */
+	static bool decode_candidate(const phrase& words, const std::string& coin,
+		std::time_t max_date, recovery_candidate& candidate);
+	static void derive_keys(recovery_candidate* candidates, size_t count);
 	monero_seed(const std::string& phrase, const std::string& coin);
 	monero_seed(std::time_t date_created, const std::string& coin);
 	std::time_t date() const {
@@ -3,63 +3,273 @@
 	All rights reserved.
 */
 
+#include "pbkdf2.h"
 #include "sha256/hash_impl.h"
+#include "sha256/hash_x86.h"
 
 #include <string.h>
 #include <stdint.h>
 
 #define BLOCK_SIZE 32
+#define STATE_WORDS 8
 
-typedef struct pbkdf_state {
-	int iterations;
-	uint32_t block_count;
-	uint8_t block[BLOCK_SIZE];
-} pbkdf_state;
+/*
+	Every iteration after the first hashes one 64 byte key pad block
+	followed by a 32 byte digest, so the second block always carries
+	the same padding.
+*/
+#define ITERATION_MSG_BITS ((64 + BLOCK_SIZE) * 8)
 
-static void pbkdf2_transform(const uint8_t* password, size_t pw_size,
-	const uint8_t* salt, size_t salt_size, pbkdf_state* state)
-{
+typedef void (*sha256_transform_fn)(uint32_t* s, const uint32_t* chunk);
+
+/* The HMAC key pads are hashed once per password, not once per iteration */
+typedef struct hmac_pads {
+	uint32_t inner[STATE_WORDS];
+	uint32_t outer[STATE_WORDS];
+} hmac_pads;
+
+static void secure_zero(void* ptr, size_t size) {
+	volatile uint8_t* p = (volatile uint8_t*)ptr;
+	while (size--) {
+		*p++ = 0;
+	}
+}
+
+static sha256_transform_fn select_transform(void) {
+#ifdef SHA256_X86
+	if (sha256_cpu_features() & SHA256_CPU_SHANI) {
+		return &sha256_transform_shani;
+	}
+#endif
+	return &sha256_transform;
+}
+
+static void hmac_pads_init(hmac_pads* pads, const uint8_t* password, size_t pw_size) {
 	hmac_sha256_state hash_state;
 	hmac_sha256_initialize(&hash_state, password, pw_size);
+	memcpy(pads->inner, hash_state.inner.s, sizeof(pads->inner));
+	memcpy(pads->outer, hash_state.outer.s, sizeof(pads->outer));
+	secure_zero(&hash_state, sizeof(hash_state));
+}
+
+/* U_1 = HMAC(P, S || INT(i)) as host order words */
+static void pbkdf2_first(const hmac_pads* pads, const uint8_t* salt, size_t salt_size,
+	uint32_t block_count, uint32_t* u)
+{
+	hmac_sha256_state hash_state;
+	memcpy(hash_state.inner.s, pads->inner, sizeof(pads->inner));
+	hash_state.inner.bytes = 64;
+	memcpy(hash_state.outer.s, pads->outer, sizeof(pads->outer));
+	hash_state.outer.bytes = 64;
+
 	hmac_sha256_write(&hash_state, salt, salt_size);
 	uint8_t block_buff[4];
 	//big endian
-	block_buff[0] = state->block_count >> 24;
-	block_buff[1] = state->block_count >> 16;
-	block_buff[2] = state->block_count >> 8;
-	block_buff[3] = state->block_count;
+	block_buff[0] = block_count >> 24;
+	block_buff[1] = block_count >> 16;
+	block_buff[2] = block_count >> 8;
+	block_buff[3] = block_count;
 	hmac_sha256_write(&hash_state, block_buff, sizeof(block_buff));
-	hmac_sha256_finalize(&hash_state, state->block);
-	hmac_sha256_initialize(&hash_state, password, pw_size);
 
-	uint8_t temp[BLOCK_SIZE];
-	memcpy(temp, state->block, BLOCK_SIZE);
+	uint8_t out[BLOCK_SIZE];
+	hmac_sha256_finalize(&hash_state, out);
+	for (unsigned i = 0; i < STATE_WORDS; ++i) {
+		uint32_t word;
+		memcpy(&word, out + 4 * i, sizeof(word));
+		u[i] = BE32(word);
+	}
+
+	secure_zero(&hash_state, sizeof(hash_state));
+	secure_zero(out, sizeof(out));
+}
+
+/* T = U_1 ^ U_2 ^ ... ^ U_c, two compressions per iteration */
+static void pbkdf2_iterate(sha256_transform_fn transform, const hmac_pads* pads,
+	int iterations, uint32_t* u, uint32_t* t)
+{
+	uint32_t block[16] = { 0 };
+	uint32_t inner[STATE_WORDS];
+	block[8] = BE32(0x80000000u);
+	block[15] = BE32((uint32_t)ITERATION_MSG_BITS);
+
+	memcpy(t, u, BLOCK_SIZE);
+
+	for (int i = 2; i <= iterations; ++i) {
+		for (unsigned j = 0; j < STATE_WORDS; ++j) {
+			block[j] = BE32(u[j]);
+		}
+		memcpy(inner, pads->inner, sizeof(inner));
+		transform(inner, block);
+
+		for (unsigned j = 0; j < STATE_WORDS; ++j) {
+			block[j] = BE32(inner[j]);
+		}
+		memcpy(u, pads->outer, BLOCK_SIZE);
+		transform(u, block);
 
-	for (unsigned i = 2; i <= state->iterations; ++i) {
-		hmac_sha256_write(&hash_state, temp, sizeof(temp));
-		hmac_sha256_finalize(&hash_state, temp);
-		for (unsigned j = 0; j < BLOCK_SIZE; ++j) {
-			state->block[j] ^= temp[j];
+		for (unsigned j = 0; j < STATE_WORDS; ++j) {
+			t[j] ^= u[j];
 		}
-		hmac_sha256_initialize(&hash_state, password, pw_size);
 	}
 
-	state->block_count++;
+	secure_zero(block, sizeof(block));
+	secure_zero(inner, sizeof(inner));
 }
 
-void pbkdf2_hmac_sha256(const uint8_t* password, size_t pw_size,
-	uint8_t* salt, size_t salt_size,
+static void store_words(const uint32_t* t, uint8_t* key, size_t size) {
+	uint8_t out[BLOCK_SIZE];
+	for (unsigned i = 0; i < STATE_WORDS; ++i) {
+		uint32_t word = BE32(t[i]);
+		memcpy(out + 4 * i, &word, sizeof(word));
+	}
+	memcpy(key, out, size);
+	secure_zero(out, sizeof(out));
+}
+
+static void pbkdf2_derive(sha256_transform_fn transform, const uint8_t* password, size_t pw_size,
+	const uint8_t* salt, size_t salt_size,
 	int iterations, uint8_t* key, size_t key_size)
 {
-	pbkdf_state state = {
-		.block_count = 1,
-		.iterations = iterations
-	};
-	while (key_size > 0) {
-		pbkdf2_transform(password, pw_size, salt, salt_size, &state);
+	hmac_pads pads;
+	uint32_t u[STATE_WORDS];
+	uint32_t t[STATE_WORDS];
+
+	hmac_pads_init(&pads, password, pw_size);
+
+	for (uint32_t block_count = 1; key_size > 0; ++block_count) {
+		pbkdf2_first(&pads, salt, salt_size, block_count, u);
+		pbkdf2_iterate(transform, &pads, iterations, u, t);
 		size_t block_size = key_size > BLOCK_SIZE ? BLOCK_SIZE : key_size;
-		memcpy(key, state.block, block_size);
-		key += BLOCK_SIZE;
-		key_size -= BLOCK_SIZE;
+		store_words(t, key, block_size);
+		key += block_size;
+		key_size -= block_size;
+	}
+
+	secure_zero(&pads, sizeof(pads));
+	secure_zero(u, sizeof(u));
+	secure_zero(t, sizeof(t));
+}
+
+void pbkdf2_hmac_sha256(const uint8_t* password, size_t pw_size,
+	const uint8_t* salt, size_t salt_size,
+	int iterations, uint8_t* key, size_t key_size)
+{
+	pbkdf2_derive(select_transform(), password, pw_size, salt, salt_size, iterations, key, key_size);
+}
+
+#ifdef SHA256_X86
+
+/* Runs up to eight jobs in the lanes of one AVX2 transform, unused lanes repeat the first job */
+__attribute__((target("avx2")))
+static void pbkdf2_derive_x8(const pbkdf2_job* jobs, size_t lanes, int iterations, size_t key_size) {
+	hmac_pads pads[SHA256_X8_LANES];
+	uint32_t u[SHA256_X8_LANES][STATE_WORDS];
+	uint32_t lane_words[SHA256_X8_LANES];
+	__m256i inner_pad[STATE_WORDS], outer_pad[STATE_WORDS];
+	__m256i uv[STATE_WORDS], tv[STATE_WORDS], inner[STATE_WORDS];
+	__m256i block[16];
+
+	for (unsigned lane = 0; lane < SHA256_X8_LANES; ++lane) {
+		const pbkdf2_job* job = &jobs[lane < lanes ? lane : 0];
+		hmac_pads_init(&pads[lane], job->password, job->pw_size);
+	}
+
+	for (unsigned j = 0; j < STATE_WORDS; ++j) {
+		for (unsigned lane = 0; lane < SHA256_X8_LANES; ++lane) {
+			lane_words[lane] = pads[lane].inner[j];
+		}
+		inner_pad[j] = _mm256_loadu_si256((const __m256i*)lane_words);
+		for (unsigned lane = 0; lane < SHA256_X8_LANES; ++lane) {
+			lane_words[lane] = pads[lane].outer[j];
+		}
+		outer_pad[j] = _mm256_loadu_si256((const __m256i*)lane_words);
+	}
+
+	for (unsigned j = STATE_WORDS; j < 16; ++j) {
+		block[j] = _mm256_setzero_si256();
+	}
+	block[8] = _mm256_set1_epi32((int)0x80000000u);
+	block[15] = _mm256_set1_epi32(ITERATION_MSG_BITS);
+
+	size_t offset = 0;
+	for (uint32_t block_count = 1; offset < key_size; ++block_count) {
+		for (unsigned lane = 0; lane < SHA256_X8_LANES; ++lane) {
+			const pbkdf2_job* job = &jobs[lane < lanes ? lane : 0];
+			pbkdf2_first(&pads[lane], job->salt, job->salt_size, block_count, u[lane]);
+		}
+		for (unsigned j = 0; j < STATE_WORDS; ++j) {
+			for (unsigned lane = 0; lane < SHA256_X8_LANES; ++lane) {
+				lane_words[lane] = u[lane][j];
+			}
+			uv[j] = tv[j] = _mm256_loadu_si256((const __m256i*)lane_words);
+		}
+
+		for (int i = 2; i <= iterations; ++i) {
+			for (unsigned j = 0; j < STATE_WORDS; ++j) {
+				block[j] = uv[j];
+				inner[j] = inner_pad[j];
+			}
+			sha256_transform_avx2_x8(inner, block);
+
+			for (unsigned j = 0; j < STATE_WORDS; ++j) {
+				block[j] = inner[j];
+				uv[j] = outer_pad[j];
+			}
+			sha256_transform_avx2_x8(uv, block);
+
+			for (unsigned j = 0; j < STATE_WORDS; ++j) {
+				tv[j] = _mm256_xor_si256(tv[j], uv[j]);
+			}
+		}
+
+		for (unsigned j = 0; j < STATE_WORDS; ++j) {
+			_mm256_storeu_si256((__m256i*)lane_words, tv[j]);
+			for (unsigned lane = 0; lane < SHA256_X8_LANES; ++lane) {
+				u[lane][j] = lane_words[lane];
+			}
+		}
+
+		size_t block_size = key_size - offset > BLOCK_SIZE ? BLOCK_SIZE : key_size - offset;
+		for (unsigned lane = 0; lane < lanes; ++lane) {
+			store_words(u[lane], jobs[lane].key + offset, block_size);
+		}
+		offset += block_size;
+	}
+
+	secure_zero(pads, sizeof(pads));
+	secure_zero(u, sizeof(u));
+	secure_zero(lane_words, sizeof(lane_words));
+	secure_zero(inner_pad, sizeof(inner_pad));
+	secure_zero(outer_pad, sizeof(outer_pad));
+	secure_zero(uv, sizeof(uv));
+	secure_zero(tv, sizeof(tv));
+	secure_zero(inner, sizeof(inner));
+	secure_zero(block, sizeof(block));
+}
+
+#endif
+
+void pbkdf2_hmac_sha256_batch(const pbkdf2_job* jobs, size_t count,
+	int iterations, size_t key_size)
+{
+	size_t done = 0;
+
+#ifdef SHA256_X86
+	int features = sha256_cpu_features();
+	/* With SHA extensions a single lane keeps up with eight AVX2 lanes, no need to batch */
+	if ((features & SHA256_CPU_AVX2) && !(features & SHA256_CPU_SHANI)) {
+		while (done < count) {
+			size_t lanes = count - done > SHA256_X8_LANES ? SHA256_X8_LANES : count - done;
+			pbkdf2_derive_x8(jobs + done, lanes, iterations, key_size);
+			done += lanes;
+		}
+		return;
+	}
+#endif
+
+	sha256_transform_fn transform = select_transform();
+	for (; done < count; ++done) {
+		pbkdf2_derive(transform, jobs[done].password, jobs[done].pw_size,
+			jobs[done].salt, jobs[done].salt_size, iterations, jobs[done].key, key_size);
 	}
 }
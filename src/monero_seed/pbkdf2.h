@@ -15,6 +15,22 @@ void pbkdf2_hmac_sha256(const uint8_t* password, size_t pw_size,
 	const uint8_t* salt, size_t salt_size,
 	int iterations, uint8_t* key, size_t key_size);
 
+typedef struct pbkdf2_job {
+	const uint8_t* password;
+	size_t pw_size;
+	const uint8_t* salt;
+	size_t salt_size;
+	uint8_t* key;
+} pbkdf2_job;
+
+/*
+	Derives keys for many passwords at once, e.g. candidate seeds during
+	recovery. On CPUs with AVX2 (and without SHA extensions) eight jobs
+	are hashed in parallel.
+*/
+void pbkdf2_hmac_sha256_batch(const pbkdf2_job* jobs, size_t count,
+	int iterations, size_t key_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,14 +23,11 @@ void reed_solomon_code::encode(gf_poly& data) const {
 }
 
 bool reed_solomon_code::check(const gf_poly& message) const {
-	auto syndrome = get_syndrome(message);
-	return syndrome.is_zero();
-}
-
-gf_poly reed_solomon_code::get_syndrome(const gf_poly& message) const {
-	gf_poly syndrome;
+	//the syndrome is zero iff the message vanishes at every root exp(i) of the generator
 	for (unsigned i = 1; i <= generator.degree(); ++i) {
-		syndrome[i - 1] = message(gf_elem(i).exp());
+		if (message.eval_exp(i) != 0) {
+			return false;
+		}
 	}
-	return syndrome;
+	return true;
 }
@@ -12,6 +12,5 @@ public:
 	void encode(gf_poly& data)  const;
 	bool check(const gf_poly& message) const;
 private:
-	gf_poly get_syndrome(const gf_poly& message) const;
 	gf_poly generator;
 };
@@ -0,0 +1,169 @@
+/*
+	SHA-256 compression functions for x86: SHA extensions (one block)
+	and AVX2 (eight independent blocks in parallel).
+
+	Both are selected at runtime, the file compiles to nothing on other
+	architectures and compilers.
+*/
+
+#ifndef _SHA256_HASH_X86_H_
+#define _SHA256_HASH_X86_H_
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SHA256_X86 1
+
+#include <stdint.h>
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define SHA256_CPU_SHANI 1
+#define SHA256_CPU_AVX2 2
+
+static const uint32_t sha256_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static int sha256_cpu_features(void) {
+	unsigned int eax, ebx, ecx, edx;
+	int features = 0;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+	int ssse3 = (ecx >> 9) & 1;
+	int sse41 = (ecx >> 19) & 1;
+	int osxsave = (ecx >> 27) & 1;
+
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+
+	if (((ebx >> 29) & 1) && ssse3 && sse41) {
+		features |= SHA256_CPU_SHANI;
+	}
+
+	if (((ebx >> 5) & 1) && osxsave) {
+		/* The OS must save the YMM registers on context switches */
+		unsigned int xcr0_lo, xcr0_hi;
+		__asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+		if ((xcr0_lo & 6) == 6) {
+			features |= SHA256_CPU_AVX2;
+		}
+	}
+
+	return features;
+}
+
+/** Same contract as sha256_transform: host order state, 16 big endian words. */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256_transform_shani(uint32_t* s, const uint32_t* chunk) {
+	const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	const uint8_t* data = (const uint8_t*)chunk;
+	__m128i state0, state1, msg, tmp, abef, cdgh;
+	__m128i m[4];
+	int i;
+
+	tmp = _mm_loadu_si128((const __m128i*)&s[0]);
+	state1 = _mm_loadu_si128((const __m128i*)&s[4]);
+	tmp = _mm_shuffle_epi32(tmp, 0xB1);          /* CDAB */
+	state1 = _mm_shuffle_epi32(state1, 0x1B);    /* EFGH */
+	state0 = _mm_alignr_epi8(tmp, state1, 8);    /* ABEF */
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0); /* CDGH */
+	abef = state0;
+	cdgh = state1;
+
+	for (i = 0; i < 4; ++i) {
+		m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16 * i)), mask);
+	}
+
+	/* Four rounds per step, the message schedule runs two steps ahead */
+	for (i = 0; i < 16; ++i) {
+		msg = _mm_add_epi32(m[i & 3], _mm_loadu_si128((const __m128i*)&sha256_k[4 * i]));
+		state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+		if (i >= 3 && i < 15) {
+			tmp = _mm_alignr_epi8(m[i & 3], m[(i - 1) & 3], 4);
+			m[(i + 1) & 3] = _mm_add_epi32(m[(i + 1) & 3], tmp);
+			m[(i + 1) & 3] = _mm_sha256msg2_epu32(m[(i + 1) & 3], m[i & 3]);
+		}
+		msg = _mm_shuffle_epi32(msg, 0x0E);
+		state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+		if (i >= 1 && i < 13) {
+			m[(i - 1) & 3] = _mm_sha256msg1_epu32(m[(i - 1) & 3], m[i & 3]);
+		}
+	}
+
+	state0 = _mm_add_epi32(state0, abef);
+	state1 = _mm_add_epi32(state1, cdgh);
+
+	tmp = _mm_shuffle_epi32(state0, 0x1B);       /* FEBA */
+	state1 = _mm_shuffle_epi32(state1, 0xB1);    /* DCHG */
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0); /* DCBA */
+	state1 = _mm_alignr_epi8(state1, tmp, 8);    /* ABEF */
+
+	_mm_storeu_si128((__m128i*)&s[0], state0);
+	_mm_storeu_si128((__m128i*)&s[4], state1);
+}
+
+#define SHA256_X8_LANES 8
+
+#define ROTR_X8(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define Ch_X8(x, y, z) _mm256_xor_si256((z), _mm256_and_si256((x), _mm256_xor_si256((y), (z))))
+#define Maj_X8(x, y, z) _mm256_or_si256(_mm256_and_si256((x), (y)), _mm256_and_si256((z), _mm256_or_si256((x), (y))))
+#define Sigma0_X8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR_X8((x), 2), ROTR_X8((x), 13)), ROTR_X8((x), 22))
+#define Sigma1_X8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR_X8((x), 6), ROTR_X8((x), 11)), ROTR_X8((x), 25))
+#define sigma0_X8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR_X8((x), 7), ROTR_X8((x), 18)), _mm256_srli_epi32((x), 3))
+#define sigma1_X8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR_X8((x), 17), ROTR_X8((x), 19)), _mm256_srli_epi32((x), 10))
+
+/**
+ * Eight independent SHA-256 transformations. s[i] holds word i of all eight states,
+ * w[i] holds message word i (host order) of all eight blocks.
+ */
+__attribute__((target("avx2")))
+static void sha256_transform_avx2_x8(__m256i* s, const __m256i* w) {
+	__m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+	__m256i x[16];
+	int i;
+
+	for (i = 0; i < 64; ++i) {
+		__m256i wi;
+		if (i < 16) {
+			wi = x[i] = w[i];
+		}
+		else {
+			wi = x[i & 15] = _mm256_add_epi32(_mm256_add_epi32(x[i & 15], sigma1_X8(x[(i - 2) & 15])),
+				_mm256_add_epi32(x[(i - 7) & 15], sigma0_X8(x[(i - 15) & 15])));
+		}
+
+		__m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, Sigma1_X8(e)),
+			_mm256_add_epi32(Ch_X8(e, f, g), _mm256_add_epi32(_mm256_set1_epi32((int)sha256_k[i]), wi)));
+		__m256i t2 = _mm256_add_epi32(Sigma0_X8(a), Maj_X8(a, b, c));
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(t1, t2);
+	}
+
+	s[0] = _mm256_add_epi32(s[0], a);
+	s[1] = _mm256_add_epi32(s[1], b);
+	s[2] = _mm256_add_epi32(s[2], c);
+	s[3] = _mm256_add_epi32(s[3], d);
+	s[4] = _mm256_add_epi32(s[4], e);
+	s[5] = _mm256_add_epi32(s[5], f);
+	s[6] = _mm256_add_epi32(s[6], g);
+	s[7] = _mm256_add_epi32(s[7], h);
+}
+
+#endif
+
+#endif
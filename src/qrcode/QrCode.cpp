@@ -21,6 +21,7 @@
 #include "QrCode_p.h"
 
 #include <QBrush>
+#include <QImage>
 #include <QPainter>
 #include <QSvgGenerator>
 #include <QVariant>
@@ -132,38 +133,60 @@ void QrCode::writeSvg(QIODevice* outputDevice, const int dpi, const int margin)
 
 QPixmap QrCode::toPixmap(const int margin) const
 {
-    if (margin < 0 || d_ptr->m_qrcode == nullptr) {
-        return QPixmap();
+    return QPixmap::fromImage(toImage(1, margin));
+}
+
+QImage QrCode::toImage(const int scale, const int margin) const
+{
+    if (scale < 1 || margin < 0 || d_ptr->m_qrcode == nullptr) {
+        return QImage();
     }
 
-    const int width = d_ptr->m_qrcode->width + margin * 2;
+    if (!d_ptr->m_image.isNull() && d_ptr->m_imageScale == scale && d_ptr->m_imageMargin == margin) {
+        return d_ptr->m_image;
+    }
 
-    QPixmap pixmap(width, width);
-    pixmap.fill(Qt::white);
+    const int rowSize = d_ptr->m_qrcode->width;
+    const int width = (rowSize + margin * 2) * scale;
 
-    QPainter painter;
-    painter.begin(&pixmap);
+    QImage image(width, width, QImage::Format_Mono);
+    if (image.isNull()) {
+        return QImage();
+    }
+    image.setColor(0, qRgb(255, 255, 255));
+    image.setColor(1, qRgb(0, 0, 0));
+    image.fill(0);
 
-    // Foreground
     // "Dots" are stored in a quint8 x quint8 array using row-major order.
     // A dot is black if the LSB of its corresponding quint8 is 1.
-    const QPen pen(Qt::black, 1);
-    const QBrush brush(Qt::black);
-    painter.setPen(pen);
-    painter.setBrush(brush);
-
-    const int rowSize = d_ptr->m_qrcode->width;
-    unsigned char* dot = d_ptr->m_qrcode->data;
+    // Each row of modules is rasterized into one scanline, which is then copied to the other scale - 1 lines.
+    const unsigned char* dot = d_ptr->m_qrcode->data;
+    const qsizetype bytesPerLine = image.bytesPerLine();
     for (int y = 0; y < rowSize; ++y) {
+        const int top = (margin + y) * scale;
+        uchar* line = image.scanLine(top);
+
         for (int x = 0; x < rowSize; ++x) {
-            if (quint8(0x01) == (static_cast<quint8>(*dot++) & quint8(0x01))) {
-                painter.drawPoint(margin +x, margin + y);
+            if ((*dot++ & 0x01) == 0) {
+                continue;
             }
+
+            // Format_Mono stores the leftmost pixel in the most significant bit
+            for (int px = (margin + x) * scale, end = px + scale; px < end; ++px) {
+                line[px >> 3] |= 0x80 >> (px & 7);
+            }
+        }
+
+        for (int i = 1; i < scale; ++i) {
+            memcpy(image.scanLine(top + i), line, bytesPerLine);
         }
     }
-    painter.end();
 
-    return pixmap;
+    d_ptr->m_image = image;
+    d_ptr->m_imageScale = scale;
+    d_ptr->m_imageMargin = margin;
+
+    return image;
 }
 
 int QrCode::width() {
@@ -71,6 +71,9 @@ public:
     void writeSvg(QIODevice* outputDevice, const int dpi, const int margin = 4) const;
     QPixmap toPixmap(const int margin = 4) const;
 
+    // 1-bit image with every module scale x scale pixels, margin is in modules
+    QImage toImage(const int scale, const int margin = 4) const;
+
     int width();
     unsigned char* data();
 
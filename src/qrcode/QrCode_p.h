@@ -22,10 +22,17 @@
 
 #include <qrencode.h>
 
+#include <QImage>
+
 struct QrCodePrivate
 {
     QRcode* m_qrcode;
 
+    // Last image returned by toImage()
+    QImage m_image;
+    int m_imageScale = 0;
+    int m_imageMargin = 0;
+
     QrCodePrivate();
     ~QrCodePrivate();
 };
@@ -22,7 +22,9 @@ void URWidget::setData(const QString &type, const std::string &data) {
     m_data = data;
     
     m_timer.stop();
+    ui->qrWidget->setQrCode(nullptr);
     allParts.clear();
+    m_partCodes.clear();
     
     if (m_data.empty()) {
         return;
@@ -43,6 +45,7 @@ void URWidget::setData(const QString &type, const std::string &data) {
     for (int i=0; i < m_urencoder->seq_len(); i++) {
         allParts.append(m_urencoder->next_part());
     }
+    m_partCodes.resize(allParts.size());
 
     m_timer.setInterval(conf()->get(Config::URmsPerFragment).toInt());
     m_timer.start();
@@ -51,18 +54,22 @@ void URWidget::setData(const QString &type, const std::string &data) {
 void URWidget::nextQR() {
     currentIndex = currentIndex % m_urencoder->seq_len();
 
-    std::string data;
+    ui->label_seq->setText(QString("%1/%2").arg(QString::number(currentIndex % m_urencoder->seq_len() + 1), QString::number(m_urencoder->seq_len())));
+
     if (conf()->get(Config::URfountainCode).toBool()) {
-        data = m_urencoder->next_part();
+        // Fountain parts are never repeated
+        std::string data = m_urencoder->next_part();
+        m_code.reset(new QrCode{QString::fromStdString(data), QrCode::Version::AUTO, QrCode::ErrorCorrectionLevel::MEDIUM});
+        ui->qrWidget->setQrCode(m_code.data());
     } else {
-        data = allParts[currentIndex];
+        // The same parts are shown in a loop, encode and rasterize each of them only once
+        auto &code = m_partCodes[currentIndex];
+        if (!code) {
+            code.reset(new QrCode{QString::fromStdString(allParts[currentIndex]), QrCode::Version::AUTO, QrCode::ErrorCorrectionLevel::MEDIUM});
+        }
+        ui->qrWidget->setQrCode(code.data());
     }
-    
-    ui->label_seq->setText(QString("%1/%2").arg(QString::number(currentIndex % m_urencoder->seq_len() + 1), QString::number(m_urencoder->seq_len())));
 
-    m_code.reset(new QrCode{QString::fromStdString(data), QrCode::Version::AUTO, QrCode::ErrorCorrectionLevel::MEDIUM});
-    ui->qrWidget->setQrCode(m_code.data());
-    
     currentIndex += 1;
 }
 
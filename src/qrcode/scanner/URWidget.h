@@ -5,6 +5,7 @@
 #define FEATHER_URWIDGET_H
 
 #include <QWidget>
+#include <QSharedPointer>
 #include <QTimer>
 
 #include "qrcode/QrCode.h"
@@ -34,6 +35,7 @@ private:
     ur::UREncoder *m_urencoder = nullptr;
     QScopedPointer<QrCode> m_code;
     QList<std::string> allParts;
+    QList<QSharedPointer<QrCode>> m_partCodes; // encoded allParts, filled on first display
     qsizetype currentIndex = 0;
     
     std::string m_data;
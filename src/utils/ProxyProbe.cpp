@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "ProxyProbe.h"
+
+#include <QNetworkProxy>
+
+#include "utils/config.h"
+
+namespace {
+    constexpr int PROBE_TIMEOUT_MS = 3000;
+
+    // SOCKS5 greeting offering "no authentication" and "username/password", see RFC 1928
+    constexpr char SOCKS5_GREETING[] = {0x05, 0x02, 0x00, 0x02};
+    constexpr char SOCKS5_VERSION = 0x05;
+    constexpr char SOCKS5_NO_ACCEPTABLE_METHODS = char(0xFF);
+}
+
+ProxyProbe::ProxyProbe(QObject *parent)
+    : QObject(parent)
+    , m_socket(new QTcpSocket(this))
+{
+    // The probe itself must never go through a proxy
+    m_socket->setProxy(QNetworkProxy::NoProxy);
+
+    connect(m_socket, &QTcpSocket::connected, this, &ProxyProbe::onConnected);
+    connect(m_socket, &QTcpSocket::readyRead, this, &ProxyProbe::onReadyRead);
+    connect(m_socket, &QTcpSocket::errorOccurred, [this](QAbstractSocket::SocketError) {
+        this->finish(false);
+    });
+
+    m_timeout.setSingleShot(true);
+    connect(&m_timeout, &QTimer::timeout, [this] {
+        this->finish(false);
+    });
+}
+
+void ProxyProbe::probe(const QString &host, quint16 port) {
+    if (m_running) {
+        m_running = false;
+        m_socket->abort();
+    }
+
+    if (conf()->get(Config::offlineMode).toBool()) {
+        QTimer::singleShot(0, this, [this] {
+            emit finished(false);
+        });
+        return;
+    }
+
+    m_running = true;
+    m_timeout.start(PROBE_TIMEOUT_MS);
+    m_socket->connectToHost(host, port);
+}
+
+bool ProxyProbe::isRunning() const {
+    return m_running;
+}
+
+void ProxyProbe::onConnected() {
+    m_socket->write(SOCKS5_GREETING, sizeof(SOCKS5_GREETING));
+}
+
+void ProxyProbe::onReadyRead() {
+    if (m_socket->bytesAvailable() < 2) {
+        return;
+    }
+
+    QByteArray reply = m_socket->read(2);
+    this->finish(reply[0] == SOCKS5_VERSION && reply[1] != SOCKS5_NO_ACCEPTABLE_METHODS);
+}
+
+void ProxyProbe::finish(bool alive) {
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    m_timeout.stop();
+    m_socket->abort();
+
+    emit finished(alive);
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_PROXYPROBE_H
+#define FEATHER_PROXYPROBE_H
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QTimer>
+
+// Checks without blocking whether a SOCKS5 proxy is alive: connects to it and performs the method negotiation of the
+// SOCKS5 handshake. A port that accepts connections but doesn't speak SOCKS5 does not count as alive.
+// The socket is reused for every probe.
+class ProxyProbe : public QObject
+{
+Q_OBJECT
+
+public:
+    explicit ProxyProbe(QObject *parent = nullptr);
+
+    //! Emits finished() when done, a probe that is still running is aborted
+    void probe(const QString &host, quint16 port);
+    bool isRunning() const;
+
+signals:
+    void finished(bool alive);
+
+private:
+    void onConnected();
+    void onReadyRead();
+    void finish(bool alive);
+
+    QTcpSocket *m_socket;
+    QTimer m_timeout;
+    bool m_running = false;
+};
+
+#endif //FEATHER_PROXYPROBE_H
@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "SeedRecovery.h"
+
+#include <QStringList>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+
+#include "monero_seed/wordlist.hpp"
+
+namespace {
+    constexpr int WORDS = 2048;
+
+    // Assignments enumerated per task
+    constexpr quint64 CHUNK_SIZE = 4096;
+
+    // Candidates per KDF batch, a multiple of the eight AVX2 lanes
+    constexpr int BATCH_SIZE = 32;
+
+    // Seed dates are quantized down to the start of a 30 day period, allow one period of clock skew
+    constexpr std::time_t DATE_SLACK = 2629746;
+}
+
+SeedRecovery::SeedRecovery(const QList<QList<int>> &words, int maxTypos, const QString &coin)
+        : m_coin(coin.toStdString())
+        , m_target(monero_seed::checksum_target(m_coin))
+{
+    const int n = monero_seed::phrase_size;
+
+    gf_elem alpha = gf_elem(1).exp();
+    gf_elem power = 1;
+    m_mul.resize(n);
+    m_solve.resize(n);
+    for (int p = 0; p < n; p++) {
+        gf_elem inverse = power;
+        inverse.inverse();
+
+        m_mul[p].resize(WORDS);
+        m_solve[p].resize(WORDS);
+        for (int w = 0; w < WORDS; w++) {
+            m_mul[p][w] = (gf_elem(w) * power).value();
+            m_solve[p][w] = (gf_elem(w) * inverse).value();
+        }
+        power *= alpha;
+    }
+
+    QVector<QVector<gf_item>> base(n);
+    for (int p = 0; p < n; p++) {
+        if (p >= words.size() || words[p].isEmpty()) {
+            for (int w = 0; w < WORDS; w++) {
+                base[p].append(w);
+            }
+            continue;
+        }
+        for (int w : words[p]) {
+            base[p].append(w);
+        }
+    }
+    this->addScenario(base);
+
+    // A mistyped word can be any word except the one that was entered
+    QVector<int> typed;
+    for (int p = 0; p < n; p++) {
+        if (base[p].size() == 1) {
+            typed.append(p);
+        }
+    }
+
+    auto widen = [](QVector<QVector<gf_item>> &scenario, int p) {
+        gf_item entered = scenario[p][0];
+        scenario[p].clear();
+        for (int w = 0; w < WORDS; w++) {
+            if (w != entered) {
+                scenario[p].append(w);
+            }
+        }
+    };
+
+    if (maxTypos >= 1) {
+        for (int i = 0; i < typed.size(); i++) {
+            auto scenario = base;
+            widen(scenario, typed[i]);
+            this->addScenario(scenario);
+        }
+    }
+
+    if (maxTypos >= 2) {
+        for (int i = 0; i < typed.size(); i++) {
+            for (int j = i + 1; j < typed.size(); j++) {
+                auto scenario = base;
+                widen(scenario, typed[i]);
+                widen(scenario, typed[j]);
+                this->addScenario(scenario);
+            }
+        }
+    }
+}
+
+void SeedRecovery::addScenario(const QVector<QVector<gf_item>> &words) {
+    Scenario scenario;
+    scenario.words = words;
+    scenario.fixed = m_target.value();
+
+    // The position with the most candidates is solved for, all others are enumerated
+    for (int p = 0; p < words.size(); p++) {
+        if (words[p].size() > 1 && (scenario.solved < 0 || words[p].size() > words[scenario.solved].size())) {
+            scenario.solved = p;
+        }
+    }
+
+    for (int p = 0; p < words.size(); p++) {
+        if (p == scenario.solved) {
+            continue;
+        }
+        if (words[p].size() == 1) {
+            scenario.fixed ^= m_mul[p][words[p][0]];
+            continue;
+        }
+
+        scenario.enumerated.append(p);
+        quint64 size = words[p].size();
+        scenario.count = (scenario.count > std::numeric_limits<quint64>::max() / size) ? std::numeric_limits<quint64>::max() : scenario.count * size;
+    }
+
+    if (scenario.solved >= 0) {
+        scenario.solvedAllowed.fill(false, WORDS);
+        for (gf_item w : words[scenario.solved]) {
+            scenario.solvedAllowed[w] = true;
+        }
+    }
+
+    m_scenarios.append(scenario);
+}
+
+quint64 SeedRecovery::enumerations() const {
+    quint64 total = 0;
+    for (const auto &scenario : m_scenarios) {
+        if (total > std::numeric_limits<quint64>::max() - scenario.count) {
+            return std::numeric_limits<quint64>::max();
+        }
+        total += scenario.count;
+    }
+    return total;
+}
+
+void SeedRecovery::run(const std::atomic<bool> &cancelled, const ProgressHandler &progress, const CandidateHandler &handler) {
+    // Assignments of all scenarios are numbered consecutively, scenario i starts at starts[i]
+    QVector<quint64> starts;
+    quint64 offset = 0;
+    for (const auto &scenario : m_scenarios) {
+        starts.append(offset);
+        offset = (offset > std::numeric_limits<quint64>::max() - scenario.count) ? std::numeric_limits<quint64>::max() : offset + scenario.count;
+    }
+
+    const quint64 total = std::max<quint64>(offset, 1);
+    const std::time_t maxDate = std::time(nullptr) + DATE_SLACK;
+    std::atomic<quint64> done = 0;
+    std::atomic<bool> stop = false;
+
+    auto runTask = [&](const Task &task) {
+        const Scenario &scenario = m_scenarios[task.scenario];
+
+        monero_seed::phrase phrase{};
+        for (int p = 0; p < scenario.words.size(); p++) {
+            if (scenario.words[p].size() == 1) {
+                phrase[p] = scenario.words[p][0];
+            }
+        }
+
+        std::vector<monero_seed::recovery_candidate> batch;
+        batch.reserve(BATCH_SIZE);
+
+        auto flush = [&] {
+            if (batch.empty()) {
+                return;
+            }
+            monero_seed::derive_keys(batch.data(), batch.size());
+            for (const auto &candidate : batch) {
+                if (handler(candidate)) {
+                    stop = true;
+                    break;
+                }
+            }
+            batch.clear();
+        };
+
+        for (quint64 index = task.begin; index < task.end; index++) {
+            if ((index & 0xFF) == 0 && (cancelled || stop)) {
+                break;
+            }
+
+            // Mixed radix decode, the last enumerated position varies fastest
+            quint64 rest = index;
+            gf_item sum = scenario.fixed;
+            for (int k = scenario.enumerated.size() - 1; k >= 0; k--) {
+                const int p = scenario.enumerated[k];
+                const auto &candidates = scenario.words[p];
+                gf_item w = candidates[rest % candidates.size()];
+                rest /= candidates.size();
+                phrase[p] = w;
+                sum ^= m_mul[p][w];
+            }
+
+            if (scenario.solved >= 0) {
+                gf_item w = m_solve[scenario.solved][sum];
+                if (!scenario.solvedAllowed[w]) {
+                    continue;
+                }
+                phrase[scenario.solved] = w;
+            }
+            else if (sum != 0) {
+                continue;
+            }
+
+            monero_seed::recovery_candidate candidate;
+            if (!monero_seed::decode_candidate(phrase, m_coin, maxDate, candidate)) {
+                continue;
+            }
+
+            batch.push_back(candidate);
+            if (batch.size() == BATCH_SIZE) {
+                flush();
+            }
+        }
+
+        flush();
+    };
+
+    // Chunks are handed out from a shared cursor as workers become free, the search space can be far too
+    // large to split up front
+    std::atomic<quint64> next = 0;
+
+    auto runWorker = [&](int &) {
+        while (!cancelled && !stop) {
+            const quint64 begin = next.fetch_add(CHUNK_SIZE);
+            if (begin >= offset) {
+                return;
+            }
+            const quint64 end = begin + std::min(offset - begin, CHUNK_SIZE);
+
+            // A chunk may span the end of one scenario and the start of the next
+            int i = std::upper_bound(starts.begin(), starts.end(), begin) - starts.begin() - 1;
+            for (quint64 position = begin; position < end; i++) {
+                const quint64 scenarioEnd = std::min(end - starts[i], m_scenarios[i].count);
+                runTask({i, position - starts[i], scenarioEnd});
+                position = starts[i] + scenarioEnd;
+            }
+
+            quint64 finished = done += (end - begin);
+            progress(static_cast<int>(finished * 100 / total));
+        }
+    };
+
+    // The global pool is shared with the wallet refresh loops
+    QThreadPool pool;
+    pool.setMaxThreadCount(QThread::idealThreadCount());
+    QVector<int> workers(pool.maxThreadCount());
+    QtConcurrent::blockingMap(&pool, workers, runWorker);
+}
+
+QString SeedRecovery::mnemonic(const monero_seed::phrase &words) {
+    QStringList mnemonic;
+    for (gf_item w : words) {
+        mnemonic.append(QString::fromStdString(wordlist::english.get_word(w)));
+    }
+    return mnemonic.join(" ");
+}
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_SEEDRECOVERY_H
+#define FEATHER_SEEDRECOVERY_H
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <functional>
+
+#include "monero_seed/monero_seed.hpp"
+
+// Searches for 14-word seeds with unknown or mistyped words.
+//
+// With one check digit a valid phrase satisfies sum(w_i * a^i) == target in GF(2048), so for every
+// assignment of all but one free word the last one is determined by the syndrome. Assignments are
+// enumerated with table lookups, only phrases with a valid checksum, zero reserved bits and a plausible
+// creation date reach the KDF, which runs in batches on all cores.
+class SeedRecovery
+{
+public:
+    //! Returns true to stop the search. Called concurrently from worker threads.
+    using CandidateHandler = std::function<bool(const monero_seed::recovery_candidate &candidate)>;
+    using ProgressHandler = std::function<void(int percent)>;
+
+    //! words holds the candidate word indices for each position, maxTypos is the number of
+    //! single-candidate words that may be wrong
+    SeedRecovery(const QList<QList<int>> &words, int maxTypos, const QString &coin);
+
+    //! Number of assignments enumerated before checksum pruning
+    quint64 enumerations() const;
+
+    void run(const std::atomic<bool> &cancelled, const ProgressHandler &progress, const CandidateHandler &handler);
+
+    static QString mnemonic(const monero_seed::phrase &words);
+
+private:
+    struct Scenario {
+        QVector<QVector<gf_item>> words;
+        int solved = -1;             // position determined by the syndrome
+        QVector<bool> solvedAllowed; // candidates of the solved position
+        QVector<int> enumerated;     // other free positions, first varies slowest
+        gf_item fixed = 0;           // target plus the contribution of single-candidate positions
+        quint64 count = 1;           // assignments of the enumerated positions
+    };
+
+    struct Task {
+        int scenario;
+        quint64 begin;
+        quint64 end;
+    };
+
+    void addScenario(const QVector<QVector<gf_item>> &words);
+
+    std::string m_coin;
+    gf_elem m_target;
+    QVector<Scenario> m_scenarios;
+
+    // m_mul[p][w] = w * a^p, m_solve[p][s] = s * a^-p
+    QVector<QVector<gf_item>> m_mul;
+    QVector<QVector<gf_item>> m_solve;
+};
+
+#endif //FEATHER_SEEDRECOVERY_H
@@ -7,16 +7,27 @@
 #include <QDirIterator>
 
 #include "utils/config.h"
+#include "utils/ProxyProbe.h"
 #include "utils/Utils.h"
 #include "utils/os/tails.h"
 #include "utils/os/whonix.h"
 
+namespace {
+    // Liveness checks back off while the proxy is down
+    constexpr int CHECK_INTERVAL_MIN_MS = 5000;
+    constexpr int CHECK_INTERVAL_MAX_MS = 60000;
+}
+
 TorManager::TorManager(QObject *parent)
     : QObject(parent)
-    , m_checkConnectionTimer(new QTimer(this))
     , m_process(new QProcess(this))
+    , m_checkConnectionTimer(new QTimer(this))
+    , m_checkInterval(CHECK_INTERVAL_MIN_MS)
+    , m_probe(new ProxyProbe(this))
 {
+    m_checkConnectionTimer->setSingleShot(true);
     connect(m_checkConnectionTimer, &QTimer::timeout, this, &TorManager::checkConnection);
+    connect(m_probe, &ProxyProbe::finished, this, &TorManager::onCheckFinished);
 
     this->torDir = Config::defaultConfigDir().filePath("tor");
 #if defined(TOR_INSTALLED)
@@ -59,7 +70,7 @@ void TorManager::stop() {
 }
 
 void TorManager::start() {
-    m_checkConnectionTimer->start(5000);
+    this->scheduleCheck(true);
 
     if (m_localTor) {
         this->checkConnection();
@@ -106,38 +117,73 @@ void TorManager::start() {
 }
 
 void TorManager::checkConnection() {
+    // A check is already in flight, its result schedules the next one
+    if (m_probe->isRunning() || (m_tailsCheck && m_tailsCheck->state() != QProcess::NotRunning)) {
+        return;
+    }
+
     // We might not be able to connect to localhost if torsocks is used to start feather
     if (Utils::isTorsocks()) {
-        this->setConnectionState(true);
+        this->onCheckFinished(true);
     }
 
     else if (WhonixOS::detect()) {
-        this->setConnectionState(true);
+        this->onCheckFinished(true);
     }
 
     else if (TailsOS::detect()) {
-        QStringList args = QStringList() << "--quiet" << "is-active" << "tails-tor-has-bootstrapped.target";
-        int code = QProcess::execute("/bin/systemctl", args);
+        if (!m_tailsCheck) {
+            m_tailsCheck = new QProcess(this);
+            connect(m_tailsCheck, &QProcess::finished, [this](int exitCode, QProcess::ExitStatus exitStatus) {
+                this->onCheckFinished(exitStatus == QProcess::NormalExit && exitCode == 0);
+            });
+            connect(m_tailsCheck, &QProcess::errorOccurred, [this](QProcess::ProcessError error) {
+                if (error == QProcess::FailedToStart) {
+                    this->onCheckFinished(false);
+                }
+            });
+        }
 
-        this->setConnectionState(code == 0);
+        QStringList args = QStringList() << "--quiet" << "is-active" << "tails-tor-has-bootstrapped.target";
+        m_tailsCheck->start("/bin/systemctl", args);
     }
 
     else if (conf()->get(Config::proxy).toInt() != Config::Proxy::Tor) {
-        this->setConnectionState(false);
+        this->onCheckFinished(false);
     }
 
     else if (m_localTor && !m_alreadyRunning) {
         QString host = conf()->get(Config::socks5Host).toString();
         quint16 port = conf()->get(Config::socks5Port).toString().toUShort();
-        this->setConnectionState(Utils::portOpen(host, port));
+        m_probe->probe(host, port);
     }
 
     else {
-        this->setConnectionState(Utils::portOpen(featherTorHost, featherTorPort));
+        m_probe->probe(featherTorHost, featherTorPort);
     }
 }
 
+void TorManager::onCheckFinished(bool connected) {
+    this->setConnectionState(connected);
+    this->scheduleCheck(connected);
+}
+
+void TorManager::scheduleCheck(bool resetBackoff) {
+    if (resetBackoff) {
+        m_checkInterval = CHECK_INTERVAL_MIN_MS;
+    } else {
+        m_checkInterval = qMin(m_checkInterval * 2, CHECK_INTERVAL_MAX_MS);
+    }
+
+    m_checkConnectionTimer->start(m_checkInterval);
+}
+
 void TorManager::setConnectionState(bool connected) {
+    // Listeners (re)connect on a change, don't wake them up for every check
+    if (this->torConnected == connected) {
+        return;
+    }
+
     this->torConnected = connected;
     emit connectionStateChanged(connected);
 }
@@ -146,6 +192,7 @@ void TorManager::stateChanged(QProcess::ProcessState state) {
     if (state == QProcess::ProcessState::Running) {
         this->setErrorMessage("");
         qWarning() << "Tor started, awaiting bootstrap";
+        this->scheduleCheck(true);
     }
     else if (state == QProcess::ProcessState::NotRunning) {
         this->setConnectionState(false);
@@ -166,6 +213,7 @@ void TorManager::handleProcessOutput() {
     if(output.contains(QByteArray("Bootstrapped 100%"))) {
         qDebug() << "Tor OK";
         this->setConnectionState(true);
+        this->scheduleCheck(true);
     }
 
     qDebug() << output;
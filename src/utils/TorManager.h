@@ -10,6 +10,8 @@
 
 #include "utils/SemanticVersion.h"
 
+class ProxyProbe;
+
 class TorManager : public QObject
 {
 Q_OBJECT
@@ -51,10 +53,12 @@ private slots:
     void handleProcessOutput();
     void handleProcessError(QProcess::ProcessError error);
     void checkConnection();
+    void onCheckFinished(bool connected);
 
 private:
     bool shouldStartTorDaemon();
     void setConnectionState(bool connected);
+    void scheduleCheck(bool resetBackoff);
     void setErrorMessage(const QString &msg);
 
     static QPointer<TorManager> m_instance;
@@ -67,6 +71,9 @@ private:
     bool m_unpacked = false;
     bool m_alreadyRunning = false;
     QTimer *m_checkConnectionTimer;
+    int m_checkInterval;
+    ProxyProbe *m_probe;
+    QProcess *m_tailsCheck = nullptr;
 };
 
 inline TorManager* torManager()
@@ -359,7 +359,7 @@ bool xdgDesktopEntryRegister() {
     return true;
 }
 
-bool portOpen(const QString &hostname, quint16 port) { // TODO: this call should be async
+bool portOpen(const QString &hostname, quint16 port) { // Blocks for up to 600 ms, use ProxyProbe on the GUI thread
     if (conf()->get(Config::offlineMode).toBool()) {
         return false;
     }
@@ -590,6 +590,40 @@ QString barrayToString(const QByteArray &data) {
     return QString::fromUtf8(data);
 }
 
+QStringList parseCSVLine(const QString &line) {
+    QStringList result;
+    QString currentField;
+    bool inQuotes = false;
+
+    for (int i = 0; i < line.length(); ++i) {
+        QChar currentChar = line[i];
+
+        if (currentChar == '"') {
+            if (inQuotes && i + 1 < line.length() && line[i + 1] == '"') {
+                currentField.append('"');
+                ++i;
+            } else {
+                inQuotes = !inQuotes;
+            }
+        } else if (currentChar == ',' && !inQuotes) {
+            result.append(currentField.trimmed());
+            currentField.clear();
+        } else {
+            currentField.append(currentChar);
+        }
+    }
+
+    result.append(currentField.trimmed());
+    return result;
+}
+
+QString csvField(const QString &field) {
+    if (!field.contains(',') && !field.contains('"') && !field.contains('\n')) {
+        return field;
+    }
+    return QString("\"%1\"").arg(QString(field).replace("\"", "\"\""));
+}
+
 QFont getMonospaceFont()
 {
     if (QFontInfo(QApplication::font()).fixedPitch()) {
@@ -702,16 +736,30 @@ void clearLayout(QLayout* layout, bool deleteWidgets)
     }
 }
 
-QString formatSyncStatus(quint64 height, quint64 target, bool daemonSync) {
+QString formatSyncStatus(quint64 height, quint64 target, bool daemonSync, qint64 eta) {
     if (height < (target - 1)) {
         QString blocks = (target >= height) ? QString::number(target - height) : "?";
         QString type = daemonSync ? "Blockchain" : "Wallet";
-        return QString("%1 sync: %2 blocks remaining").arg(type, blocks);
+        QString status = QString("%1 sync: %2 blocks remaining").arg(type, blocks);
+        if (eta >= 0) {
+            status += QString(" (%1 left)").arg(formatDuration(eta));
+        }
+        return status;
     }
 
     return "Synchronized";
 }
 
+QString formatDuration(qint64 seconds) {
+    if (seconds < 60) {
+        return QString("%1s").arg(QString::number(seconds));
+    }
+    if (seconds < 3600) {
+        return QString("%1m %2s").arg(QString::number(seconds / 60), QString::number(seconds % 60));
+    }
+    return QString("%1h %2m").arg(QString::number(seconds / 3600), QString::number((seconds % 3600) / 60));
+}
+
 QString formatRestoreHeight(quint64 height) {
     const QDateTime restoreDate = appData()->restoreHeights[constants::networkType]->heightToDate(height);
     return QString("%1  (%2)").arg(QString::number(height), restoreDate.toString("yyyy-MM-dd"));
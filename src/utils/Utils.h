@@ -99,6 +99,8 @@ namespace Utils
 
     void applicationLogHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
     QString barrayToString(const QByteArray &data);
+    QStringList parseCSVLine(const QString &line);
+    QString csvField(const QString &field);
 
     bool isLocalUrl(const QUrl &url);
 
@@ -118,7 +120,8 @@ namespace Utils
     QWindow* windowForQObject(QObject* object);
     void clearLayout(QLayout *layout, bool deleteWidgets = true);
 
-    QString formatSyncStatus(quint64 height, quint64 target, bool daemonSync = false);
+    QString formatSyncStatus(quint64 height, quint64 target, bool daemonSync = false, qint64 eta = -1);
+    QString formatDuration(qint64 seconds);
     QString formatRestoreHeight(quint64 height);
 
     QString getVersion();
@@ -8,10 +8,26 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QSslConfiguration>
+#include <QtConcurrent/QtConcurrent>
 
 #include "utils/config.h"
+#include "utils/TorManager.h"
 #include "utils/Utils.h"
 
+namespace {
+    // Messages larger than this (txFiatHistory, nodes) are parsed on a worker thread
+    constexpr qsizetype ASYNC_PARSE_THRESHOLD = 64 * 1024;
+
+    QJsonObject parseMessage(const QByteArray &message) {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(message, &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+            return {};
+        }
+        return doc.object();
+    }
+}
+
 WebsocketClient::WebsocketClient(QObject *parent)
     : QObject(parent)
     , webSocket(new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this))
@@ -49,6 +65,8 @@ WebsocketClient::WebsocketClient(QObject *parent)
 
     connect(&m_connectionTimeout, &QTimer::timeout, this, &WebsocketClient::onConnectionTimeout);
 
+    connect(torManager(), &TorManager::connectionStateChanged, this, &WebsocketClient::onTorConnectionStateChanged);
+
     m_websocketUrlIndex = QRandomGenerator::global()->bounded(m_websocketUrls[this->networkType()].length());
     this->nextWebsocketUrl();
 }
@@ -122,6 +140,12 @@ void WebsocketClient::onError(QAbstractSocket::SocketError error) {
     }
 }
 
+void WebsocketClient::onTorConnectionStateChanged(bool connected) {
+    if (connected && conf()->get(Config::proxy).toInt() == Config::Proxy::Tor) {
+        this->start();
+    }
+}
+
 void WebsocketClient::nextWebsocketUrl() {
     Config::Proxy networkType = this->networkType();
     m_websocketUrlIndex = (m_websocketUrlIndex+1)%m_websocketUrls[networkType].length();
@@ -151,19 +175,44 @@ void WebsocketClient::onConnectionTimeout() {
 void WebsocketClient::onbinaryMessageReceived(const QByteArray &message) {
 //    qDebug() << "WebSocket received:" << message;
 
-    if (!Utils::validateJSON(message)) {
-        qCritical() << "Could not interpret WebSocket message as JSON";
-        return;
+    PendingMessage pending;
+    if (message.size() > ASYNC_PARSE_THRESHOLD) {
+        pending.async = true;
+        pending.future = QtConcurrent::run(parseMessage, message);
+        pending.future.then(this, [this](const QJsonObject &) {
+            this->processMessages();
+        });
+    } else {
+        pending.object = parseMessage(message);
     }
 
-    QJsonDocument doc = QJsonDocument::fromJson(message);
-    QJsonObject object = doc.object();
-    if(!object.contains("cmd") || !object.contains("data")) {
-        qCritical() << "Invalid WebSocket message received";
-        return;
-    }
+    m_messages.enqueue(pending);
+    this->processMessages();
+}
+
+void WebsocketClient::processMessages() {
+    while (!m_messages.isEmpty()) {
+        if (m_messages.head().async && !m_messages.head().future.isFinished()) {
+            return;
+        }
+
+        PendingMessage pending = m_messages.dequeue();
+        QJsonObject object = pending.async ? pending.future.result() : pending.object;
 
-    emit WSMessage(object);
+        if (object.isEmpty()) {
+            qCritical() << "Could not interpret WebSocket message as JSON";
+            continue;
+        }
+
+        auto cmd = object.constFind("cmd");
+        auto data = object.constFind("data");
+        if (cmd == object.constEnd() || data == object.constEnd()) {
+            qCritical() << "Invalid WebSocket message received";
+            continue;
+        }
+
+        emit WSMessage(cmd->toString(), *data);
+    }
 }
 
 WebsocketClient::~WebsocketClient() = default;
\ No newline at end of file
@@ -5,6 +5,9 @@
 #define FEATHER_WEBSOCKETCLIENT_H
 
 #include <QObject>
+#include <QFuture>
+#include <QJsonObject>
+#include <QQueue>
 #include <QWebSocket>
 #include <QTimer>
 #include <QPointer>
@@ -27,7 +30,7 @@ public:
 
 signals:
     void connectionEstablished();
-    void WSMessage(QJsonObject message);
+    void WSMessage(const QString &cmd, const QJsonValue &data);
 
 private slots:
     void onConnected();
@@ -36,8 +39,17 @@ private slots:
     void onbinaryMessageReceived(const QByteArray &message);
     void onError(QAbstractSocket::SocketError error);
     void onConnectionTimeout();
+    void onTorConnectionStateChanged(bool connected);
 
 private:
+    struct PendingMessage {
+        QJsonObject object;
+        QFuture<QJsonObject> future; // only for messages parsed on a worker thread
+        bool async = false;
+    };
+
+    void processMessages();
+
     Config::Proxy networkType();
     const QHash<Config::Proxy, QVector<QUrl>> m_websocketUrls = {
             {Config::Proxy::None, {
@@ -60,6 +72,9 @@ private:
     int m_timeout = 20;
     int m_websocketUrlIndex = 0;
     bool m_stopped = false;
+
+    // Messages are dispatched in the order they were received, also when a large one is still being parsed
+    QQueue<PendingMessage> m_messages;
 };
 
 #endif //FEATHER_WEBSOCKETCLIENT_H
@@ -13,60 +13,74 @@ WebsocketNotifier::WebsocketNotifier(QObject *parent)
 {
     connect(websocketClient, &WebsocketClient::WSMessage, this, &WebsocketNotifier::onWSMessage);
 
-    for (const auto& plugin : PluginRegistry::getPlugins()) {
-        m_pluginSubscriptions << plugin->socketData();
-    }
-}
+    m_handlers["blockheights"] = [this](const QJsonValue &data) {
+        QJsonObject heights = data.toObject();
+        int mainnet = heights.value("mainnet").toInt();
+        int stagenet = heights.value("stagenet").toInt();
 
-QPointer<WebsocketNotifier> WebsocketNotifier::m_instance(nullptr);
+        emit BlockHeightsReceived(mainnet, stagenet);
+    };
 
-void WebsocketNotifier::onWSMessage(const QJsonObject &msg) {
-    QString cmd = msg.value("cmd").toString();
+    m_handlers["nodes"] = [this](const QJsonValue &data) {
+        this->onWSNodes(data.toArray());
+    };
 
-    m_lastMessageReceived = QDateTime::currentDateTimeUtc();
-    m_cache[cmd] = msg;
+    m_handlers["crypto_rates"] = [this](const QJsonValue &data) {
+        emit CryptoRatesReceived(data.toArray());
+    };
 
-    if (cmd == "blockheights") {
-        QJsonObject data = msg.value("data").toObject();
-        int mainnet = data.value("mainnet").toInt();
-        int stagenet = data.value("stagenet").toInt();
+    m_handlers["fiat_rates"] = [this](const QJsonValue &data) {
+        emit FiatRatesReceived(data.toObject());
+    };
 
-        emit BlockHeightsReceived(mainnet, stagenet);
-    }
+    m_handlers["txFiatHistory"] = [this](const QJsonValue &data) {
+        emit TxFiatHistoryReceived(data.toObject());
+    };
 
-    else if(cmd == "nodes") {
-        this->onWSNodes(msg.value("data").toArray());
-    }
+#if defined(CHECK_UPDATES)
+    m_handlers["updates"] = [this](const QJsonValue &data) {
+        this->onWSUpdates(data.toObject());
+    };
+#endif
 
-    else if(cmd == "crypto_rates") {
-        QJsonArray crypto_rates = msg.value("data").toArray();
-        emit CryptoRatesReceived(crypto_rates);
+    for (const auto& plugin : PluginRegistry::getPlugins()) {
+        for (const auto& cmd : plugin->socketData()) {
+            if (m_handlers.contains(cmd)) {
+                continue;
+            }
+            m_handlers[cmd] = [this, cmd](const QJsonValue &data) {
+                emit dataReceived(cmd, data);
+            };
+        }
     }
+}
 
-    else if(cmd == "fiat_rates") {
-        QJsonObject fiat_rates = msg.value("data").toObject();
-        emit FiatRatesReceived(fiat_rates);
-    }
+QPointer<WebsocketNotifier> WebsocketNotifier::m_instance(nullptr);
 
-    else if(cmd == "txFiatHistory") {
-        auto txFiatHistory_data = msg.value("data").toObject();
-        emit TxFiatHistoryReceived(txFiatHistory_data);
-    }
+void WebsocketNotifier::onWSMessage(const QString &cmd, const QJsonValue &data) {
+    m_lastMessageReceived = QDateTime::currentDateTimeUtc();
 
-#if defined(CHECK_UPDATES)
-    else if (cmd == "updates") {
-        this->onWSUpdates(msg.value("data").toObject());
+    auto handler = m_handlers.constFind(cmd);
+    if (handler == m_handlers.constEnd()) {
+        return;
     }
-#endif
 
-    else if (m_pluginSubscriptions.contains(cmd)) {
-        emit dataReceived(cmd, msg.value("data"));
+    // Nodes are cached after decoding
+    if (cmd != "nodes") {
+        m_cache[cmd] = data;
     }
+
+    (*handler)(data);
 }
 
 void WebsocketNotifier::emitCache() {
-    for (const auto &msg : m_cache) {
-        this->onWSMessage(msg);
+    for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+        m_handlers.value(it.key())(it.value());
+    }
+
+    if (!m_nodes.isEmpty()) {
+        QList<FeatherNode> nodes = m_nodes;
+        emit NodesReceived(nodes);
     }
 }
 
@@ -100,6 +114,7 @@ void WebsocketNotifier::onWSNodes(const QJsonArray &nodes) {
         l.append(node);
     }
 
+    m_nodes = l;
     emit NodesReceived(l);
 }
 
@@ -7,6 +7,8 @@
 #include <QObject>
 #include <QMap>
 
+#include <functional>
+
 #include "WebsocketClient.h"
 #include "networktype.h"
 #include "nodes.h"
@@ -38,7 +40,7 @@ signals:
     void dataReceived(const QString &type, const QJsonValue &json);
 
 private slots:
-    void onWSMessage(const QJsonObject &msg);
+    void onWSMessage(const QString &cmd, const QJsonValue &data);
 
     void onWSNodes(const QJsonArray &nodes);
     void onWSUpdates(const QJsonObject &updates);
@@ -46,8 +48,11 @@ private slots:
 private:
     static QPointer<WebsocketNotifier> m_instance;
 
-    QStringList m_pluginSubscriptions;
-    QHash<QString, QJsonObject> m_cache;
+    using Handler = std::function<void(const QJsonValue &data)>;
+
+    QHash<QString, Handler> m_handlers;
+    QHash<QString, QJsonValue> m_cache;
+    QList<FeatherNode> m_nodes; // decoded once, replayed by emitCache
     QDateTime m_lastMessageReceived;
 };
 
@@ -110,6 +110,8 @@ Nodes::Nodes(QObject *parent, Wallet *wallet)
     if (m_wallet) {
         connect(m_wallet, &Wallet::walletRefreshed, this, &Nodes::onWalletRefreshed);
     }
+
+    connect(torManager(), &TorManager::connectionStateChanged, this, &Nodes::onTorConnectionStateChanged);
 }
 
 void Nodes::loadConfig() {
@@ -432,6 +434,17 @@ void Nodes::onWalletRefreshed() {
     }
 }
 
+void Nodes::onTorConnectionStateChanged(bool connected) {
+    if (!connected || conf()->get(Config::proxy) != Config::Proxy::Tor) {
+        return;
+    }
+
+    // Connection attempts made while Tor was down have failed, retry now instead of waiting for the next cycle
+    if (m_wallet && m_wallet->connectionStatus() == Wallet::ConnectionStatus_Disconnected) {
+        this->autoConnect();
+    }
+}
+
 bool Nodes::useOnionNodes() {
     if (conf()->get(Config::proxy) != Config::Proxy::Tor) {
         return false;
@@ -174,6 +174,7 @@ public slots:
 
 private slots:
     void onWalletRefreshed();
+    void onTorConnectionStateChanged(bool connected);
 
 private:
     Wallet *m_wallet = nullptr;
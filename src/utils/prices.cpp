@@ -9,11 +9,58 @@
 #include "config.h"
 #include "constants.h"
 
+namespace {
+    // Formatted strings kept per snapshot, the balances of a few wallets and accounts
+    constexpr int MAX_CACHED_FIAT_STRINGS = 256;
+}
+
+quint64 PriceSnapshot::version() const {
+    return m_version;
+}
+
+int PriceSnapshot::currencyId(const QString &symbol) const {
+    auto it = m_ids.constFind(symbol);
+    if (it != m_ids.constEnd()) {
+        return it.value();
+    }
+    return m_ids.value(symbol.toUpper(), -1);
+}
+
+double PriceSnapshot::rate(int from, int to) const {
+    if (from < 0 || to < 0) {
+        return 0.0;
+    }
+    return m_rates[from * m_size + to];
+}
+
+double PriceSnapshot::convert(int from, int to, double amount) const {
+    if (amount <= 0.0) {
+        return 0.0;
+    }
+    return amount * this->rate(from, to);
+}
+
+double PriceSnapshot::convert(const QString &symbolFrom, const QString &symbolTo, double amount) const {
+    if (symbolFrom == symbolTo) {
+        return amount;
+    }
+    return this->convert(this->currencyId(symbolFrom), this->currencyId(symbolTo), amount);
+}
+
 Prices::Prices(QObject *parent)
     : QObject(parent)
+    , m_snapshot(std::make_shared<PriceSnapshot>())
 {
 }
 
+std::shared_ptr<const PriceSnapshot> Prices::snapshot() const {
+    return m_snapshot;
+}
+
+quint64 Prices::version() const {
+    return m_snapshot->version();
+}
+
 void Prices::cryptoPricesReceived(const QJsonArray &data) {
     this->markets.clear();
 
@@ -31,6 +78,7 @@ void Prices::cryptoPricesReceived(const QJsonArray &data) {
         this->markets.insert(ms.symbol.toUpper(), ms);
     }
 
+    this->rebuild();
     emit cryptoPricesUpdated();
 }
 
@@ -39,62 +87,72 @@ void Prices::fiatPricesReceived(const QJsonObject &data) {
     for (const auto &currency : ratesData.keys()) {
         this->rates.insert(currency, ratesData.value(currency).toDouble());
     }
+
+    this->rebuild();
     emit fiatPricesUpdated();
 }
 
-double Prices::convert(QString symbolFrom, QString symbolTo, double amount) {
-    if (symbolFrom == symbolTo)
-        return amount;
-    if (amount <= 0.0)
-        return 0.0;
+double Prices::convert(const QString &symbolFrom, const QString &symbolTo, double amount) const {
+    return m_snapshot->convert(symbolFrom, symbolTo, amount);
+}
 
-    symbolFrom = symbolFrom.toUpper();
-    symbolTo = symbolTo.toUpper();
+QString Prices::atomicUnitsToPreferredFiatString(quint64 amount, bool wrapInParens) {
+    QString fiatCurrency = conf()->get(Config::preferredFiatCurrency).toString();
 
-    double usdPrice;
-    if (this->markets.contains(symbolFrom)) {
-        usdPrice = this->markets[symbolFrom].price_usd * amount;
+    if (m_fiatStringsVersion != m_snapshot->version() || m_fiatStringsCurrency != fiatCurrency || m_fiatStrings.size() >= MAX_CACHED_FIAT_STRINGS) {
+        m_fiatStrings.clear();
+        m_fiatStringsVersion = m_snapshot->version();
+        m_fiatStringsCurrency = fiatCurrency;
     }
-    else if (this->rates.contains(symbolFrom)) {
-        if (symbolFrom == "USD") {
-            usdPrice = amount;
-        } else {
-            double rate = this->rates[symbolFrom];
-            if (rate == 0.0) {
-                qWarning() << "Division by zero avoided: rate for" << symbolFrom << "is zero";
-                return 0.0;
-            }
-            usdPrice = amount / rate;
-        }
+
+    auto it = m_fiatStrings.constFind(amount);
+    if (it == m_fiatStrings.constEnd()) {
+        double fiatAmount = m_snapshot->convert("XMR", fiatCurrency, amount / constants::cdiv);
+        it = m_fiatStrings.insert(amount, Utils::amountToCurrencyString(fiatAmount, fiatCurrency));
     }
-    else {
-        return 0.0;
+
+    if (wrapInParens) {
+        return QString("(%1)").arg(it.value());
     }
+    return it.value();
+}
 
-    if (symbolTo == "USD")
-        return usdPrice;
+void Prices::rebuild() {
+    auto snapshot = std::make_shared<PriceSnapshot>();
+    snapshot->m_version = m_snapshot->version() + 1;
 
-    if (this->markets.contains(symbolTo)) {
-        double price = this->markets[symbolTo].price_usd;
-        if (price == 0.0) {
-            qWarning() << "Division by zero avoided: price_usd for" << symbolTo << "is zero";
-            return 0.0;
+    // USD value of one unit of every currency. Crypto markets come first, a symbol that is both a market and a fiat
+    // rate is converted at its market price.
+    QVector<double> usdValue;
+    auto add = [&snapshot, &usdValue](const QString &symbol, double value) {
+        if (value <= 0.0 || snapshot->m_ids.contains(symbol)) {
+            return;
         }
-        return usdPrice / price;
-    }
-    else if (this->rates.contains(symbolTo))
-        return usdPrice * this->rates[symbolTo];
+        snapshot->m_ids.insert(symbol, usdValue.size());
+        usdValue.append(value);
+    };
 
-    return 0.0;
-}
-
-QString Prices::atomicUnitsToPreferredFiatString(quint64 amount, bool wrapInParens) {
-    QString fiatCurrency = conf()->get(Config::preferredFiatCurrency).toString();
-    double fiatAmount = convert("XMR", fiatCurrency, amount / constants::cdiv);
-    QString currencyString = Utils::amountToCurrencyString(fiatAmount, fiatCurrency);
+    for (auto it = this->markets.cbegin(); it != this->markets.cend(); ++it) {
+        add(it.key(), it.value().price_usd);
+    }
+    add("USD", 1.0);
+    for (auto it = this->rates.cbegin(); it != this->rates.cend(); ++it) {
+        // Rates are units per USD
+        if (it.value() <= 0.0) {
+            qWarning() << "Ignoring rate for" << it.key() << ": not positive";
+            continue;
+        }
+        add(it.key().toUpper(), 1.0 / it.value());
+    }
 
-    if (wrapInParens) {
-        return QString("(%1)").arg(currencyString);
+    const int n = usdValue.size();
+    snapshot->m_size = n;
+    snapshot->m_rates.resize(n * n);
+    for (int from = 0; from < n; from++) {
+        for (int to = 0; to < n; to++) {
+            snapshot->m_rates[from * n + to] = usdValue[from] / usdValue[to];
+        }
     }
-    return currencyString;
+
+    m_snapshot = std::move(snapshot);
 }
@@ -5,6 +5,10 @@
 #define FEATHER_PRICES_H
 
 #include <QObject>
+#include <QHash>
+#include <QVector>
+
+#include <memory>
 
 #include "utils/Utils.h"
 
@@ -16,6 +20,30 @@ struct marketStruct {
     double price_usd_change_pct_24h;
 };
 
+// Conversion rates between every pair of known currencies, indexed by currency id. A snapshot never changes after it
+// is built, consumers can hold on to one and compare versions to tell whether prices changed.
+class PriceSnapshot
+{
+public:
+    //! Increases every time prices are received
+    quint64 version() const;
+
+    //! -1 if the currency is unknown
+    int currencyId(const QString &symbol) const;
+
+    double rate(int from, int to) const;
+    double convert(int from, int to, double amount) const;
+    double convert(const QString &symbolFrom, const QString &symbolTo, double amount) const;
+
+private:
+    friend class Prices;
+
+    quint64 m_version = 0;
+    QHash<QString, int> m_ids;   // Upper case symbol
+    int m_size = 0;
+    QVector<double> m_rates;     // m_rates[from * m_size + to]
+};
+
 class Prices : public QObject
 {
 Q_OBJECT
@@ -25,16 +53,29 @@ public:
     QMap<QString, double> rates;
     QMap<QString, marketStruct> markets;
 
+    std::shared_ptr<const PriceSnapshot> snapshot() const;
+    quint64 version() const;
+
 public slots:
     void cryptoPricesReceived(const QJsonArray &data);
     void fiatPricesReceived(const QJsonObject &data);
 
-    double convert(QString symbolFrom, QString symbolTo, double amount);
+    double convert(const QString &symbolFrom, const QString &symbolTo, double amount) const;
     QString atomicUnitsToPreferredFiatString(quint64 amount, bool wrapInParens = false);
 
 signals:
     void fiatPricesUpdated();
     void cryptoPricesUpdated();
+
+private:
+    void rebuild();
+
+    std::shared_ptr<const PriceSnapshot> m_snapshot;
+
+    // Formatted amounts in the preferred fiat currency, valid for one snapshot version
+    QHash<quint64, QString> m_fiatStrings;
+    quint64 m_fiatStringsVersion = 0;
+    QString m_fiatStringsCurrency;
 };
 
 #endif //FEATHER_PRICES_H
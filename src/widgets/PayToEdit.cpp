@@ -6,8 +6,12 @@
 
 #include <QApplication>
 #include <QClipboard>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMimeData>
 #include <QScrollBar>
+#include <QtConcurrent>
 
 #include "libwalletqt/WalletManager.h"
 #include "utils/Utils.h"
@@ -16,17 +20,27 @@
 #include "qrcode/utils/QrCodeUtils.h"
 #endif
 
+namespace {
+    // Fewer new addresses than this are validated inline, typing a line should not wait for a worker
+    constexpr qsizetype ASYNC_VALIDATION_THRESHOLD = 32;
+    constexpr qsizetype MAX_CACHED_ADDRESSES = 100000;
+}
+
 PayToEdit::PayToEdit(QWidget *parent) : QPlainTextEdit(parent)
 {
     this->setFont(Utils::getMonospaceFont());
 
     connect(this->document(), &QTextDocument::contentsChanged, this, &PayToEdit::updateSize);
     connect(this, &QPlainTextEdit::textChanged, this, &PayToEdit::checkText);
+    connect(&m_validationWatcher, &QFutureWatcher<bool>::finished, this, &PayToEdit::onValidationFinished);
 
     this->updateSize();
 }
 
 void PayToEdit::setNetType(NetworkType::Type netType) {
+    if (netType != m_netType) {
+        m_addressValid.clear();
+    }
     m_netType = netType;
 }
 
@@ -72,12 +86,62 @@ bool PayToEdit::isOpenAlias() {
         return false;
     }
     auto parts = text.split(',');
-    if (parts.size() > 0 and WalletManager::addressValid(parts[0], m_netType)) {
+    if (parts.size() > 0 and this->addressValid(parts[0])) {
         return false;
     }
     return true;
 }
 
+bool PayToEdit::isValidating() const {
+    return m_validationWatcher.isRunning();
+}
+
+bool PayToEdit::parsePayouts(const QByteArray &data, QStringList &lines, QString &error) {
+    lines.clear();
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    if (parseError.error == QJsonParseError::NoError) {
+        if (!doc.isArray()) {
+            error = "Expected a JSON array of {\"address\", \"amount\"} objects";
+            return false;
+        }
+        const QJsonArray payouts = doc.array();
+        for (qsizetype i = 0; i < payouts.size(); ++i) {
+            QJsonObject payout = payouts[i].toObject();
+            QString address = payout.value("address").toString().trimmed();
+            // Amounts may be strings or numbers, QVariant gives the shortest representation of a double
+            QString amount = payout.value("amount").toVariant().toString().trimmed();
+            if (address.isEmpty() || amount.isEmpty()) {
+                error = QString("Payout #%1 is missing an address or amount").arg(i + 1);
+                return false;
+            }
+            lines.append(QString("%1, %2").arg(address, amount));
+        }
+        return true;
+    }
+
+    // Anything that is not JSON is read as CSV, a header row is skipped
+    const QStringList rows = QString::fromUtf8(data).split('\n');
+    for (qsizetype i = 0; i < rows.size(); ++i) {
+        QString row = rows[i].trimmed();
+        if (row.isEmpty()) {
+            continue;
+        }
+        row.remove('"');
+        QStringList fields = row.split(',');
+        if (fields.size() != 2) {
+            error = QString("Line #%1: expected two comma-separated values: (address, amount)").arg(i + 1);
+            return false;
+        }
+        if (lines.isEmpty() && fields[0].trimmed().compare("address", Qt::CaseInsensitive) == 0) {
+            continue;
+        }
+        lines.append(QString("%1, %2").arg(fields[0].trimmed(), fields[1].trimmed()));
+    }
+    return true;
+}
+
 void PayToEdit::keyPressEvent(QKeyEvent *event) {
     if (event->matches(QKeySequence::Paste)) {
         bool uri = this->pasteEvent(QApplication::clipboard()->mimeData());
@@ -143,9 +207,59 @@ void PayToEdit::checkText() {
         }
     }
 
+    // Only addresses we have not seen before need validating. A pasted payout list has thousands of
+    // them, those are validated on worker threads and the lines are parsed again when they are done.
+    QStringList unknown;
+    QSet<QString> seen;
+    for (const auto &line : lines) {
+        QString address = line.section(',', 0, 0).trimmed();
+        if (address.isEmpty() || m_addressValid.contains(address) || m_validating.contains(address) || seen.contains(address)) {
+            continue;
+        }
+        seen.insert(address);
+        unknown.append(address);
+    }
+
+    if (unknown.size() > ASYNC_VALIDATION_THRESHOLD) {
+        if (m_validationWatcher.isRunning()) {
+            // Picked up by the next batch, once the running one is done
+            m_validating.unite(seen);
+        }
+        else {
+            if (m_addressValid.size() > MAX_CACHED_ADDRESSES) {
+                m_addressValid.clear();
+            }
+
+            m_validationInput = unknown;
+            m_validating = seen;
+            NetworkType::Type netType = m_netType;
+            m_validationWatcher.setFuture(QtConcurrent::mapped(m_validationInput, [netType](const QString &address) {
+                return WalletManager::addressValid(address, netType);
+            }));
+        }
+    }
+    else {
+        for (const auto &address : unknown) {
+            this->addressValid(address);
+        }
+    }
+
     this->parseAsMultiline(lines);
 }
 
+void PayToEdit::onValidationFinished() {
+    QFuture<bool> future = m_validationWatcher.future();
+    for (qsizetype i = 0; i < m_validationInput.size() && i < future.resultCount(); ++i) {
+        m_addressValid.insert(m_validationInput[i], future.resultAt(i));
+    }
+    m_validationInput.clear();
+    m_validating.clear();
+
+    // Picks up lines that were edited while we were validating
+    this->checkText();
+    emit validationFinished();
+}
+
 void PayToEdit::updateSize() {
     qreal lineHeight = QFontMetrics(this->document()->defaultFont()).height();
     qreal docHeight = this->document()->size().height();
@@ -176,12 +290,23 @@ quint64 PayToEdit::parseAmount(QString amount) {
 }
 
 QString PayToEdit::parseAddress(QString address) {
-    if (!WalletManager::addressValid(address.trimmed(), m_netType)) {
+    if (!this->addressValid(address.trimmed())) {
         return "";
     }
     return address;
 }
 
+bool PayToEdit::addressValid(const QString &address) {
+    auto it = m_addressValid.constFind(address);
+    if (it != m_addressValid.constEnd()) {
+        return it.value();
+    }
+
+    bool valid = WalletManager::addressValid(address, m_netType);
+    m_addressValid.insert(address, valid);
+    return valid;
+}
+
 void PayToEdit::parseAsMultiline(const QStringList &lines) {
     m_outputs.clear();
     m_total = 0;
@@ -189,6 +314,11 @@ void PayToEdit::parseAsMultiline(const QStringList &lines) {
     int i = -1;
     for (auto &line : lines) {
         i++;
+        if (!m_validating.isEmpty() && m_validating.contains(line.section(',', 0, 0).trimmed())) {
+            // Neither an output nor an error until the background validation is done
+            continue;
+        }
+
         PartialTxOutput output = this->parseAddressAndAmount(line);
         if (output.address.isEmpty() && output.amount == 0) {
             m_errors.append(PayToLineError(line, "Expected two comma-separated values: (address, amount)", i, true));
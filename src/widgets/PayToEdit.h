@@ -6,7 +6,10 @@
 #define FEATHER_PAYTOEDIT_H
 
 #include <QObject>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QPlainTextEdit>
+#include <QSet>
 
 #include "utils/Utils.h"
 
@@ -48,8 +51,15 @@ public:
     void payToMany();
     bool isOpenAlias();
 
+    //! True while addresses of a large paste or import are being validated in the background
+    bool isValidating() const;
+
+    //! Turns a CSV (address,amount per line) or JSON ([{"address", "amount"}]) payout file into lines
+    static bool parsePayouts(const QByteArray &data, QStringList &lines, QString &error);
+
 signals:
     void dataPasted(const QString &data);
+    void validationFinished();
 
 protected:
     void keyPressEvent(QKeyEvent *event) override;
@@ -63,8 +73,10 @@ private:
     PartialTxOutput parseAddressAndAmount(const QString &line);
     quint64 parseAmount(QString amount);
     QString parseAddress(QString address);
+    bool addressValid(const QString &address);
 
     void parseAsMultiline(const QStringList &lines);
+    void onValidationFinished();
 
     int m_heightMin = 0;
     int m_heightMax = 150;
@@ -73,6 +85,12 @@ private:
 
     QVector<PayToLineError> m_errors;
     QVector<PartialTxOutput> m_outputs;
+
+    // Address validation is a full base58 decode, results are cached so edits only validate changed lines
+    QHash<QString, bool> m_addressValid;
+    QStringList m_validationInput;
+    QSet<QString> m_validating;
+    QFutureWatcher<bool> m_validationWatcher;
 };
 
 #endif //FEATHER_PAYTOEDIT_H
@@ -3,9 +3,8 @@
 
 #include "QrCodeWidget.h"
 
-#include <QColor>
+#include <QImage>
 #include <QPainter>
-#include <QPen>
 
 QrCodeWidget::QrCodeWidget(QWidget *parent) : QWidget(parent)
 {
@@ -20,6 +19,12 @@ QrCodeWidget::~QrCodeWidget()
 void QrCodeWidget::setQrCode(QrCode *qrCode) {
     // Note: QrCodeWidget does NOT take ownership - caller manages lifecycle
     m_qrcode = qrCode;
+    m_cache = QPixmap();
+
+    if (!m_qrcode) {
+        this->update();
+        return;
+    }
 
     int k = m_qrcode->width();
     if (k > 0) {
@@ -32,16 +37,11 @@ void QrCodeWidget::setQrCode(QrCode *qrCode) {
 }
 
 void QrCodeWidget::paintEvent(QPaintEvent *event) {
-    // Implementation adapted from Electrum: qrcodewidget.py
+    // Layout adapted from Electrum: qrcodewidget.py
     if (!m_qrcode) {
         return;
     }
 
-    QColor black{0, 0, 0, 255};
-    QColor white{255, 255, 255, 255};
-    QPen blackPen{black};
-    blackPen.setJoinStyle(Qt::MiterJoin);
-
     QPainter painter(this);
 
     auto r = painter.viewport();
@@ -50,28 +50,29 @@ void QrCodeWidget::paintEvent(QPaintEvent *event) {
         qWarning() << "Division by zero avoided: QR code width is zero";
         return;
     }
-    int margin = 10;
-    int framesize = std::min(r.width(), r.height());
-    int boxsize = int((framesize - (2*margin)) / k);
-    int size = k*boxsize;
-    int left = (framesize - size)/2;
-    int top = (framesize - size)/2;
-
-    painter.setBrush(white);
-    painter.setPen(white);
-    painter.drawRect(0, 0, framesize, framesize);
-
-    painter.setBrush(black);
-    painter.setPen(blackPen);
-
-    unsigned char* dot = m_qrcode->data();
-    for (int row = 0; row < k; row++) {
-        for (int column = 0; column < k; column++) {
-            if (quint8(0x01) == (static_cast<quint8>(*dot++) & quint8(0x01))) {
-                painter.drawRect(int(left+(column*boxsize)), int(top+(row*boxsize)), boxsize - 1, boxsize - 1);
-            }
-        }
+
+    const qreal dpr = this->devicePixelRatioF();
+    if (m_cache.isNull() || m_cacheSize != r.size() || m_cacheDpr != dpr) {
+        // Rendered in device pixels, so modules stay crisp on high DPI screens
+        int margin = qRound(10 * dpr);
+        int framesize = qRound(std::min(r.width(), r.height()) * dpr);
+        int boxsize = std::max(1, (framesize - (2*margin)) / k);
+        int size = k*boxsize;
+        int offset = (framesize - size)/2;
+
+        QImage frame(framesize, framesize, QImage::Format_RGB32);
+        frame.fill(Qt::white);
+        QPainter framePainter(&frame);
+        framePainter.drawImage(offset, offset, m_qrcode->toImage(boxsize, 0));
+        framePainter.end();
+
+        m_cache = QPixmap::fromImage(frame);
+        m_cache.setDevicePixelRatio(dpr);
+        m_cacheSize = r.size();
+        m_cacheDpr = dpr;
     }
+
+    painter.drawPixmap(0, 0, m_cache);
 }
 
 bool QrCodeWidget::hasHeightForWidth() const {
@@ -4,6 +4,7 @@
 #ifndef FEATHER_QRCODEWIDGET_H
 #define FEATHER_QRCODEWIDGET_H
 
+#include <QPixmap>
 #include <QWidget>
 
 #include "qrcode/QrCode.h"
@@ -24,6 +25,11 @@ protected:
 
 private:
     QrCode *m_qrcode = nullptr;
+
+    // The rendered frame, valid for m_cacheSize and m_cacheDpr
+    QPixmap m_cache;
+    QSize m_cacheSize;
+    qreal m_cacheDpr = 0;
 };
 
 #endif //FEATHER_QRCODEWIDGET_H
@@ -71,12 +71,23 @@ BalanceTickerWidget::BalanceTickerWidget(QWidget *parent, Wallet *wallet, bool t
 }
 
 void BalanceTickerWidget::updateDisplay() {
-    double balance = (m_totalBalance ? m_wallet->balanceAll() : m_wallet->balance()) / constants::cdiv;
+    quint64 balance = m_totalBalance ? m_wallet->balanceAll() : m_wallet->balance();
     QString fiatCurrency = conf()->get(Config::preferredFiatCurrency).toString();
-    double balanceFiatAmount = appData()->prices.convert("XMR", fiatCurrency, balance);
+    auto prices = appData()->prices.snapshot();
+
+    if (m_displayed && balance == m_balance && prices->version() == m_pricesVersion && fiatCurrency == m_fiatCurrency) {
+        return;
+    }
+
+    double balanceFiatAmount = prices->convert("XMR", fiatCurrency, balance / constants::cdiv);
     if (balanceFiatAmount < 0)
         return;
     this->setFiatText(balanceFiatAmount, fiatCurrency);
+
+    m_displayed = true;
+    m_balance = balance;
+    m_pricesVersion = prices->version();
+    m_fiatCurrency = fiatCurrency;
 }
 
 // PriceTickerWidget
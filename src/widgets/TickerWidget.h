@@ -49,6 +49,12 @@ public slots:
 
 private:
     bool m_totalBalance;
+
+    // What is displayed, balance updates don't change it most of the time
+    bool m_displayed = false;
+    quint64 m_balance = 0;
+    quint64 m_pricesVersion = 0;
+    QString m_fiatCurrency;
 };
 
 class PriceTickerWidget : public TickerWidgetBase
@@ -12,6 +12,7 @@
 
 struct TxWizardFields {
     UnsignedTransaction *utx = nullptr;
+    std::string unsignedTx;
     PendingTransaction *tx = nullptr;
     std::string signedTx;
     QrCodeScanWidget *scanWidget = nullptr;
@@ -4,6 +4,7 @@
 #include "PageOTS_ExportSignedTx.h"
 #include "ui_PageOTS_Export.h"
 
+#include <QFile>
 #include <QFileDialog>
 
 #include "OfflineTxSigningWizard.h"
@@ -25,6 +26,12 @@ PageOTS_ExportSignedTx::PageOTS_ExportSignedTx(QWidget *parent, Wallet *wallet,
     ui->label_step->hide();
     ui->label_instructions->setText("Scan this animated QR code with your view-only wallet.");
 
+    m_label_progress = new QLabel(this);
+    m_label_progress->setWordWrap(true);
+    m_progressBar = new QProgressBar(this);
+    ui->layout_extra->addWidget(m_label_progress);
+    ui->layout_extra->addWidget(m_progressBar);
+
     connect(ui->btn_export, &QPushButton::clicked, this, &PageOTS_ExportSignedTx::exportSignedTx);
     connect(ui->combo_method, &QComboBox::currentIndexChanged, [this](int index){
         conf()->set(Config::offlineTxSigningMethod, index);
@@ -39,12 +46,14 @@ void PageOTS_ExportSignedTx::exportSignedTx() {
         return;
     }
 
-    bool r = m_wizardFields->utx->sign(fn);
-
-    if (!r) {
-        Utils::showError(this, "Failed to save transaction to file");
+    // Write the set that was already signed, signing again would produce a different transaction
+    const std::string &signedTx = m_wizardFields->signedTx;
+    QFile file(fn);
+    if (!file.open(QIODevice::WriteOnly) || file.write(signedTx.data(), signedTx.size()) != static_cast<qint64>(signedTx.size())) {
+        Utils::showError(this, "Failed to save transaction to file", file.errorString());
         return;
     }
+    file.close();
 
     QFileInfo fileInfo(fn);
     Utils::openDir(this, "Transaction saved successfully", fileInfo.absolutePath());
@@ -54,11 +63,65 @@ void PageOTS_ExportSignedTx::initializePage() {
     if (!m_wizardFields->utx) {
         Utils::showError(this, "Unknown error");
         this->close();
+        return;
     }
 
     ui->combo_method->setCurrentIndex(conf()->get(Config::offlineTxSigningMethod).toInt());
-    m_wizardFields->utx->signToStr(m_wizardFields->signedTx);
+
+    m_wizardFields->signedTx.clear();
+    m_signedCount = 0;
+    ui->combo_method->setEnabled(false);
+    ui->stackedWidget->setEnabled(false);
+    m_progressBar->setMaximum(0);
+    m_progressBar->setValue(0);
+    m_progressBar->show();
+    m_label_progress->setText("Signing transactions..");
+    m_label_progress->show();
+
+    delete m_signer;
+    m_signer = m_wallet->createTxSigner(m_wizardFields->unsignedTx);
+    m_signer->setParent(this);
+
+    connect(m_signer, &TxSigner::parsed, this, [this](int txCount) {
+        m_progressBar->setMaximum(txCount);
+        m_label_progress->setText(QString("Signing transactions (0/%1)").arg(txCount));
+    });
+    connect(m_signer, &TxSigner::txSigned, this, &PageOTS_ExportSignedTx::onTxSigned);
+    connect(m_signer, &TxSigner::finished, this, &PageOTS_ExportSignedTx::onSigningFinished);
+    connect(this->wizard(), &QWizard::rejected, m_signer, &TxSigner::cancel);
+
+    emit completeChanged();
+    m_signer->start();
+}
+
+void PageOTS_ExportSignedTx::onTxSigned(int index, const QString &txid) {
+    m_signedCount += 1;
+    m_progressBar->setValue(m_signedCount);
+    m_label_progress->setText(QString("Signing transactions (%1/%2)\nSigned transaction %3: %4").arg(QString::number(m_signedCount), QString::number(m_signer->txCount()), QString::number(index + 1), txid));
+}
+
+void PageOTS_ExportSignedTx::onSigningFinished(bool success) {
+    if (!success) {
+        QString error = m_signer->errorString();
+        m_progressBar->hide();
+        m_label_progress->setText(error.isEmpty() ? "Signing cancelled" : error);
+        if (!error.isEmpty()) {
+            Utils::showError(this, "Failed to sign transaction", error);
+        }
+        return;
+    }
+
+    m_wizardFields->signedTx = m_signer->signedTx();
+    m_progressBar->hide();
+    m_label_progress->hide();
+    ui->combo_method->setEnabled(true);
+    ui->stackedWidget->setEnabled(true);
     ui->widget_UR->setData("xmr-txsigned", m_wizardFields->signedTx);
+    emit completeChanged();
+}
+
+bool PageOTS_ExportSignedTx::isComplete() const {
+    return !m_wizardFields->signedTx.empty();
 }
 
 int PageOTS_ExportSignedTx::nextId() const {
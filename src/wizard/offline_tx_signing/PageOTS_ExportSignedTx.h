@@ -5,7 +5,12 @@
 #define FEATHER_PAGEOTS_EXPORTSIGNEDTX_H
 
 #include <QWizardPage>
+#include <QLabel>
+#include <QPointer>
+#include <QProgressBar>
+
 #include "Wallet.h"
+#include "TxSigner.h"
 #include "OfflineTxSigningWizard.h"
 
 namespace Ui {
@@ -20,14 +25,22 @@ public:
     explicit PageOTS_ExportSignedTx(QWidget *parent, Wallet *wallet, TxWizardFields *wizardFields);
     void initializePage() override;
     [[nodiscard]] int nextId() const override;
+    [[nodiscard]] bool isComplete() const override;
 
 private slots:
     void exportSignedTx();
+    void onTxSigned(int index, const QString &txid);
+    void onSigningFinished(bool success);
 
 private:
     Ui::PageOTS_Export *ui;
     Wallet *m_wallet;
     TxWizardFields *m_wizardFields;
+
+    QPointer<TxSigner> m_signer;
+    QProgressBar *m_progressBar;
+    QLabel *m_label_progress;
+    int m_signedCount = 0;
 };
 
 #endif //FEATHER_PAGEOTS_EXPORTSIGNEDTX_H
@@ -58,6 +58,7 @@ void PageOTS_ImportOffline::importFromStr(const std::string &data) {
         ui->frame_status->show();
         ui->frame_status->setInfo(icons()->icon("confirmed.svg"), "Unsigned transaction imported successfully");
         m_wizardFields->utx = utx;
+        m_wizardFields->unsignedTx = data;
         m_wizardFields->readyToSign = true;
     }
     else {
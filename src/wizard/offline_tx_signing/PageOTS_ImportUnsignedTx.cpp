@@ -28,6 +28,7 @@ void PageOTS_ImportUnsignedTx::importFromStr(const std::string &data) {
     }
 
     m_wizardFields->utx = utx;
+    m_wizardFields->unsignedTx = data;
     m_wizardFields->readyToSign = true;
     PageOTS_Import::onSuccess();
 }